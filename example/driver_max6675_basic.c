@@ -55,6 +55,7 @@ uint8_t max6675_basic_init(void)
     DRIVER_MAX6675_LINK_SPI_DEINIT(&gs_handle, max6675_interface_spi_deinit);
     DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&gs_handle, max6675_interface_spi_read_cmd);
     DRIVER_MAX6675_LINK_DELAY_MS(&gs_handle, max6675_interface_delay_ms);
+    DRIVER_MAX6675_LINK_GET_TICK_MS(&gs_handle, max6675_interface_get_tick_ms);
     DRIVER_MAX6675_LINK_DEBUG_PRINT(&gs_handle, max6675_interface_debug_print);
     
     /* max6675 init */
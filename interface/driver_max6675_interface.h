@@ -51,25 +51,28 @@ extern "C"{
  */
 
 /**
- * @brief  interface spi bus init
- * @return status code
- *         - 0 success
- *         - 1 spi init failed
- * @note   none
+ * @brief     interface spi bus init
+ * @param[in] *ctx pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
  */
-uint8_t max6675_interface_spi_init(void);
+uint8_t max6675_interface_spi_init(void *ctx);
 
 /**
- * @brief  interface spi bus deinit
- * @return status code
- *         - 0 success
- *         - 1 spi deinit failed
- * @note   none
+ * @brief     interface spi bus deinit
+ * @param[in] *ctx pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
  */
-uint8_t max6675_interface_spi_deinit(void);
+uint8_t max6675_interface_spi_deinit(void *ctx);
 
 /**
  * @brief      interface spi bus read command
+ * @param[in]  *ctx pointer to a user context
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len length of data buffer
  * @return     status code
@@ -77,7 +80,36 @@ uint8_t max6675_interface_spi_deinit(void);
  *             - 1 read failed
  * @note       none
  */
-uint8_t max6675_interface_spi_read_cmd(uint8_t *buf, uint16_t len);
+uint8_t max6675_interface_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      interface spi bus async read command
+ * @param[in]  *ctx pointer to a user context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @param[in]  *complete pointer to a completion function
+ * @param[in]  *param pointer to a completion parameter
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       this function is optional, it starts the read and returns at once and the complete
+ *             function must be called with the transfer result and param after cs is released
+ */
+uint8_t max6675_interface_spi_read_cmd_async(void *ctx, uint8_t *buf, uint16_t len, void (*complete)(uint8_t res, void *param), void *param);
+
+/**
+ * @brief      interface spi bus read many command
+ * @param[in]  *ctx pointer to a user context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       this function is optional and reads frame i from the i-th device into buf + i * len,
+ *             a bus without one chip select per device must return 1 for num > 1
+ */
+uint8_t max6675_interface_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);
 
 /**
  * @brief     interface delay ms
@@ -86,6 +118,20 @@ uint8_t max6675_interface_spi_read_cmd(uint8_t *buf, uint16_t len);
  */
 void max6675_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface get tick ms
+ * @return monotonic tick in ms
+ * @note   none
+ */
+uint32_t max6675_interface_get_tick_ms(void);
+
+/**
+ * @brief     interface wait until a tick
+ * @param[in] tick absolute get_tick_ms tick
+ * @note      this function is optional and returns at once when the tick has passed
+ */
+void max6675_interface_wait_until_ms(uint32_t tick);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
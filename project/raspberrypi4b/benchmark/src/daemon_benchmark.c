@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      daemon_benchmark.c
+ * @brief     daemon benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "daemon_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include "raspberrypi4b_driver_max6675_server.h"
+#include <pthread.h>
+#include <time.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define DAEMON_BENCHMARK_FULL            2          /**< subscribers of every record */
+#define DAEMON_BENCHMARK_DECIMATED       2          /**< subscribers of every DAEMON_BENCHMARK_DECIMATION-th record */
+#define DAEMON_BENCHMARK_STALLED         1          /**< subscribers that never read */
+#define DAEMON_BENCHMARK_DECIMATION      10         /**< decimation of the decimated subscribers */
+#define DAEMON_BENCHMARK_BATCH           64         /**< records published per 1 ms poll */
+#define DAEMON_BENCHMARK_ROUND_MS        250        /**< run time of one round */
+#define DAEMON_BENCHMARK_SUBSCRIBERS     (DAEMON_BENCHMARK_FULL + DAEMON_BENCHMARK_DECIMATED + DAEMON_BENCHMARK_STALLED)
+
+/**
+ * @brief daemon benchmark subscriber structure definition
+ */
+typedef struct daemon_benchmark_subscriber_s
+{
+    pthread_t thread;              /**< subscriber thread */
+    uint32_t decimation;           /**< requested decimation, 0 never reads */
+    uint64_t records;              /**< received records */
+    uint64_t bad;                  /**< records out of order or with a wrong frame */
+} daemon_benchmark_subscriber_t;
+
+/**
+ * @brief benchmark buffer definition
+ */
+static raspberrypi4b_max6675_server_t gs_server;                                          /**< server */
+static daemon_benchmark_subscriber_t gs_subscriber[DAEMON_BENCHMARK_SUBSCRIBERS];        /**< subscribers */
+static char gs_path[108];                                                                 /**< socket path */
+static uint32_t gs_ready;                                                                 /**< subscribed threads */
+static uint32_t gs_release;                                                               /**< stalled subscribers may read */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_daemon_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief     subscriber thread
+ * @param[in] *arg pointer to a daemon benchmark subscriber structure
+ * @return    NULL
+ * @note      record n has the tick n and the frame (n & 0xFFF) << 3, so the ticks of one subscriber
+ *            must grow in steps of its decimation and a dropped record only leaves a gap
+ */
+static void *a_daemon_benchmark_subscriber(void *arg)
+{
+    daemon_benchmark_subscriber_t *sub = (daemon_benchmark_subscriber_t *)arg;
+    uint8_t buf[8192];
+    uint32_t decimation;
+    uint32_t len;
+    uint32_t off;
+    int64_t last;
+    int fd;
+    
+    decimation = (sub->decimation != 0) ? sub->decimation : 1;
+    if (raspberrypi4b_max6675_server_subscribe(gs_path, decimation, &fd) != 0)
+    {
+        sub->bad++;
+        __atomic_add_fetch(&gs_ready, 1, __ATOMIC_RELEASE);
+        
+        return NULL;
+    }
+    __atomic_add_fetch(&gs_ready, 1, __ATOMIC_RELEASE);
+    
+    /* a stalled subscriber waits for the end of the run */
+    while ((sub->decimation == 0) && (__atomic_load_n(&gs_release, __ATOMIC_ACQUIRE) == 0))
+    {
+        (void)usleep(1000);
+    }
+    
+    /* read until the server closes the socket */
+    last = -1;
+    len = 0;
+    while (1)
+    {
+        ssize_t n;
+        
+        n = read(fd, buf + len, sizeof(buf) - len);
+        if (n <= 0)
+        {
+            break;
+        }
+        len += (uint32_t)n;
+        for (off = 0; off + RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE <= len; off += RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE)
+        {
+            uint32_t tick;
+            uint16_t frame;
+            
+            tick = (uint32_t)buf[off] | ((uint32_t)buf[off + 1] << 8) |
+                   ((uint32_t)buf[off + 2] << 16) | ((uint32_t)buf[off + 3] << 24);
+            frame = (uint16_t)(buf[off + 4] | (buf[off + 5] << 8));
+            if (((int64_t)tick <= last) || ((tick % decimation) != 0) ||
+                (frame != (uint16_t)((tick & 0xFFF) << 3)) || (buf[off + 6] != 0) || (buf[off + 7] != 0))
+            {
+                sub->bad++;
+            }
+            last = tick;
+            sub->records++;
+        }
+        memmove(buf, buf + off, len - off);
+        len -= off;
+    }
+    (void)close(fd);
+    
+    return NULL;
+}
+
+/**
+ * @brief     daemon benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      a server on a temporary socket publishes numbered records to full rate, decimated and
+ *            stalled subscriber threads, every received record is checked and the stalled one must
+ *            be closed without slowing the publisher
+ */
+uint8_t daemon_benchmark(uint32_t times)
+{
+    uint32_t events;
+    uint32_t tick;
+    uint32_t started;
+    uint32_t i;
+    uint64_t full;
+    uint64_t decimated;
+    uint64_t bad;
+    double worst;
+    double t0;
+    double t1;
+    
+    /* a private socket */
+    (void)snprintf(gs_path, sizeof(gs_path), "/tmp/max6675_benchmark_%d.sock", (int)getpid());
+    if (raspberrypi4b_max6675_server_open(&gs_server, gs_path) != 0)
+    {
+        max6675_interface_debug_print("daemon: server open failed.\n");
+        
+        return 1;
+    }
+    
+    /* start the subscribers and accept them */
+    gs_ready = 0;
+    gs_release = 0;
+    for (started = 0; started < DAEMON_BENCHMARK_SUBSCRIBERS; started++)
+    {
+        memset(&gs_subscriber[started], 0, sizeof(daemon_benchmark_subscriber_t));
+        if (started < DAEMON_BENCHMARK_FULL)
+        {
+            gs_subscriber[started].decimation = 1;
+        }
+        else if (started < DAEMON_BENCHMARK_FULL + DAEMON_BENCHMARK_DECIMATED)
+        {
+            gs_subscriber[started].decimation = DAEMON_BENCHMARK_DECIMATION;
+        }
+        else
+        {
+            gs_subscriber[started].decimation = 0;
+        }
+        if (pthread_create(&gs_subscriber[started].thread, NULL, a_daemon_benchmark_subscriber, &gs_subscriber[started]) != 0)
+        {
+            max6675_interface_debug_print("daemon: thread create failed.\n");
+            
+            break;
+        }
+    }
+    while (__atomic_load_n(&gs_ready, __ATOMIC_ACQUIRE) < started)
+    {
+        (void)raspberrypi4b_max6675_server_poll(&gs_server, 1, &events);
+    }
+    do
+    {
+        /* the decimation requests */
+        (void)raspberrypi4b_max6675_server_poll(&gs_server, 10, &events);
+    } while (events != 0);
+    
+    /* publish in batches and serve the subscribers between them */
+    tick = 0;
+    worst = 0.0;
+    t0 = a_daemon_benchmark_time();
+    t1 = t0;
+    while ((started == DAEMON_BENCHMARK_SUBSCRIBERS) && (t1 - t0 < (double)times * DAEMON_BENCHMARK_ROUND_MS / 1000.0))
+    {
+        double s;
+        
+        s = a_daemon_benchmark_time();
+        for (i = 0; i < DAEMON_BENCHMARK_BATCH; i++)
+        {
+            (void)raspberrypi4b_max6675_server_publish(&gs_server, tick, (uint16_t)((tick & 0xFFF) << 3), 0, 0);
+            tick++;
+        }
+        (void)raspberrypi4b_max6675_server_flush(&gs_server);
+        t1 = a_daemon_benchmark_time();
+        if (t1 - s > worst)
+        {
+            worst = t1 - s;
+        }
+        (void)raspberrypi4b_max6675_server_poll(&gs_server, 1, &events);
+        t1 = a_daemon_benchmark_time();
+    }
+    
+    /* close every subscription and collect the results */
+    __atomic_store_n(&gs_release, 1, __ATOMIC_RELEASE);
+    (void)raspberrypi4b_max6675_server_close(&gs_server);
+    full = 0;
+    decimated = 0;
+    bad = (started == DAEMON_BENCHMARK_SUBSCRIBERS) ? 0 : 1;
+    for (i = 0; i < started; i++)
+    {
+        (void)pthread_join(gs_subscriber[i].thread, NULL);
+        if (gs_subscriber[i].decimation == 1)
+        {
+            full += gs_subscriber[i].records;
+        }
+        else if (gs_subscriber[i].decimation != 0)
+        {
+            decimated += gs_subscriber[i].records;
+        }
+        else
+        {
+            /* only what was queued before it was closed */
+        }
+        bad += gs_subscriber[i].bad;
+    }
+    
+    /* output */
+    max6675_interface_debug_print("daemon: published %u records in %0.2fs, worst batch %0.1fus.\n",
+                                  tick, t1 - t0, worst * 1000000.0);
+    max6675_interface_debug_print("daemon: full subscribers got %llu of %llu records, decimated subscribers got %llu of %llu.\n",
+                                  (unsigned long long)full, (unsigned long long)tick * DAEMON_BENCHMARK_FULL,
+                                  (unsigned long long)decimated,
+                                  (unsigned long long)((tick + DAEMON_BENCHMARK_DECIMATION - 1) / DAEMON_BENCHMARK_DECIMATION) * DAEMON_BENCHMARK_DECIMATED);
+    max6675_interface_debug_print("daemon: %u gathered writes, %llu records dropped.\n",
+                                  gs_server.writes, (unsigned long long)gs_server.dropped);
+    max6675_interface_debug_print("daemon: %u slow subscribers closed, %llu bad records.\n",
+                                  gs_server.disconnected, (unsigned long long)bad);
+    
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      decode_benchmark.c
+ * @brief     decode benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "decode_benchmark.h"
+#include "driver_max6675_interface.h"
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief benchmark frame number definition
+ */
+#define DECODE_BENCHMARK_FRAMES        (1024 * 1024)        /**< 1M frames */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_decode_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief     decode benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      every supported path is checked against the scalar path and its frames per second are printed
+ */
+uint8_t decode_benchmark(uint32_t times)
+{
+    const char *name[3] = {"scalar", "sse2", "avx2"};
+    uint8_t res = 0;
+    uint8_t *buf;
+    uint16_t *raw;
+    uint16_t *raw_check;
+    float *temp;
+    float *temp_check;
+    uint8_t *status;
+    uint8_t *status_check;
+    uint32_t i;
+    uint32_t j;
+    int p;
+    
+    /* malloc the buffers */
+    buf = (uint8_t *)malloc(DECODE_BENCHMARK_FRAMES * 2);
+    raw = (uint16_t *)malloc(DECODE_BENCHMARK_FRAMES * sizeof(uint16_t));
+    raw_check = (uint16_t *)malloc(DECODE_BENCHMARK_FRAMES * sizeof(uint16_t));
+    temp = (float *)malloc(DECODE_BENCHMARK_FRAMES * sizeof(float));
+    temp_check = (float *)malloc(DECODE_BENCHMARK_FRAMES * sizeof(float));
+    status = (uint8_t *)malloc(DECODE_BENCHMARK_FRAMES);
+    status_check = (uint8_t *)malloc(DECODE_BENCHMARK_FRAMES);
+    if ((buf == NULL) || (raw == NULL) || (raw_check == NULL) || (temp == NULL) ||
+        (temp_check == NULL) || (status == NULL) || (status_check == NULL))
+    {
+        max6675_interface_debug_print("decode: malloc failed.\n");
+        res = 1;
+        
+        goto exit;
+    }
+    
+    /* make random frames */
+    srand(0);
+    for (i = 0; i < DECODE_BENCHMARK_FRAMES * 2; i++)
+    {
+        buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+    
+    /* make the first and the last frames 0xFFF8, d15 is set and must not reach raw, the status is corrupt */
+    buf[0] = 0xFF;
+    buf[1] = 0xF8;
+    buf[DECODE_BENCHMARK_FRAMES * 2 - 2] = 0xFF;
+    buf[DECODE_BENCHMARK_FRAMES * 2 - 1] = 0xF8;
+    
+    /* make an open frame and a valid frame of 25C */
+    buf[2] = 0x03;
+    buf[3] = 0x24;
+    buf[4] = 0x03;
+    buf[5] = 0x20;
+    
+    /* make the reference result */
+    (void)decode_batch_path(DECODE_PATH_SCALAR, buf, DECODE_BENCHMARK_FRAMES, raw_check, temp_check, status_check);
+    
+    /* run all paths */
+    for (p = DECODE_PATH_SCALAR; p <= DECODE_PATH_AVX2; p++)
+    {
+        double start;
+        double cost;
+        
+        /* check the path */
+        if (decode_path_supported((decode_path_t)p) == 0)
+        {
+            max6675_interface_debug_print("decode: %s is not supported.\n", name[p]);
+            
+            continue;
+        }
+        
+        /* run the path */
+        start = a_decode_benchmark_time();
+        for (j = 0; j < times; j++)
+        {
+            (void)decode_batch_path((decode_path_t)p, buf, DECODE_BENCHMARK_FRAMES, raw, temp, status);
+        }
+        cost = a_decode_benchmark_time() - start;
+        
+        /* check the result */
+        if ((memcmp(raw, raw_check, DECODE_BENCHMARK_FRAMES * sizeof(uint16_t)) != 0) ||
+            (memcmp(temp, temp_check, DECODE_BENCHMARK_FRAMES * sizeof(float)) != 0) ||
+            (memcmp(status, status_check, DECODE_BENCHMARK_FRAMES) != 0) ||
+            (raw[0] != 0x0FFF) || (raw[DECODE_BENCHMARK_FRAMES - 1] != 0x0FFF) ||
+            (status[0] != 6) || (status[DECODE_BENCHMARK_FRAMES - 1] != 6) ||
+            (status[1] != 4) || (status[2] != 0) || (raw[2] != 100))
+        {
+            max6675_interface_debug_print("decode: %s check failed.\n", name[p]);
+            res = 1;
+            
+            goto exit;
+        }
+        
+        /* output */
+        if (cost > 0.0)
+        {
+            max6675_interface_debug_print("decode: %s %0.1f Mframes/s.\n", name[p],
+                                          (double)DECODE_BENCHMARK_FRAMES * times / cost / 1000000.0);
+        }
+    }
+    
+    exit:
+    free(buf);
+    free(raw);
+    free(raw_check);
+    free(temp);
+    free(temp_check);
+    free(status);
+    free(status_check);
+    
+    return res;
+}
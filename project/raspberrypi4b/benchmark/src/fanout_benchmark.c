@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      fanout_benchmark.c
+ * @brief     fanout benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "fanout_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+
+/**
+ * @brief benchmark definition
+ */
+#define FANOUT_BENCHMARK_LINES        32        /**< simulated thermocouples on the bus */
+
+/**
+ * @brief benchmark buffer definition
+ */
+static spi_fanout_sim_t gs_sim;                                                         /**< cs simulator */
+static spi_fanout_t gs_fanout;                                                          /**< fanout */
+static raspberrypi4b_max6675_fanout_device_t gs_device[FANOUT_BENCHMARK_LINES];        /**< devices */
+static max6675_handle_t gs_handle[FANOUT_BENCHMARK_LINES];                             /**< handles */
+static max6675_handle_t *gs_handle_list[FANOUT_BENCHMARK_LINES];                       /**< handle list */
+static max6675_group_t gs_group;                                                        /**< group */
+
+/**
+ * @brief     fanout benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      simulated gpio cs lines are read one by one and as a group, the gpio calls per
+ *            sample are printed and every frame and cs state is checked, a cached group must
+ *            be read without any gpio call
+ */
+uint8_t fanout_benchmark(uint32_t times)
+{
+    uint16_t raw[FANOUT_BENCHMARK_LINES];
+    float temp[FANOUT_BENCHMARK_LINES];
+    uint8_t status[FANOUT_BENCHMARK_LINES];
+    uint32_t sets;
+    uint32_t samples;
+    uint32_t bad;
+    uint32_t i;
+    uint16_t j;
+    
+    /* every line returns its own temperature */
+    if (spi_fanout_sim_init(&gs_fanout, &gs_sim, "/dev/spidev0.0", FANOUT_BENCHMARK_LINES) != 0)
+    {
+        max6675_interface_debug_print("fanout: init failed.\n");
+        
+        return 1;
+    }
+    for (j = 0; j < FANOUT_BENCHMARK_LINES; j++)
+    {
+        gs_sim.frame[j] = (uint16_t)((400 + j) << 3);
+        RASPBERRYPI4B_MAX6675_FANOUT_DEVICE_INIT(&gs_device[j], &gs_fanout, j);
+        DRIVER_MAX6675_LINK_INIT(&gs_handle[j], max6675_handle_t);
+        DRIVER_MAX6675_LINK_SPI_INIT(&gs_handle[j], raspberrypi4b_max6675_fanout_spi_init);
+        DRIVER_MAX6675_LINK_SPI_DEINIT(&gs_handle[j], raspberrypi4b_max6675_fanout_spi_deinit);
+        DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&gs_handle[j], raspberrypi4b_max6675_fanout_spi_read_cmd);
+        DRIVER_MAX6675_LINK_CONTEXT(&gs_handle[j], &gs_device[j]);
+        DRIVER_MAX6675_LINK_DELAY_MS(&gs_handle[j], max6675_interface_delay_ms);
+        DRIVER_MAX6675_LINK_GET_TICK_MS(&gs_handle[j], max6675_interface_get_tick_ms);
+        DRIVER_MAX6675_LINK_DEBUG_PRINT(&gs_handle[j], max6675_interface_debug_print);
+        if (max6675_init(&gs_handle[j]) != 0)
+        {
+            max6675_interface_debug_print("fanout: max6675 init failed.\n");
+            
+            return 1;
+        }
+        gs_handle_list[j] = &gs_handle[j];
+    }
+    DRIVER_MAX6675_GROUP_LINK_INIT(&gs_group, max6675_group_t);
+    DRIVER_MAX6675_GROUP_LINK_SPI_READ_MANY_COMMAND(&gs_group, raspberrypi4b_max6675_fanout_spi_read_many_cmd);
+    DRIVER_MAX6675_GROUP_LINK_CONTEXT(&gs_group, &gs_device[0]);
+    if (max6675_group_init(&gs_group, gs_handle_list, FANOUT_BENCHMARK_LINES) != 0)
+    {
+        max6675_interface_debug_print("fanout: group init failed.\n");
+        
+        return 1;
+    }
+    bad = 0;
+    samples = times * FANOUT_BENCHMARK_LINES;
+    
+    /* one select and one release per sample */
+    sets = gs_sim.sets;
+    for (i = 0; i < times; i++)
+    {
+        for (j = 0; j < FANOUT_BENCHMARK_LINES; j++)
+        {
+            if ((max6675_read(&gs_handle[j], &raw[j], &temp[j]) != 0) || (raw[j] != 400 + j))
+            {
+                bad++;
+            }
+        }
+    }
+    sets = gs_sim.sets - sets;
+    max6675_interface_debug_print("fanout: single %0.3f gpio set/sample.\n", (double)sets / samples);
+    
+    /* the release shares the set with the next select */
+    sets = gs_sim.sets;
+    for (i = 0; i < times; i++)
+    {
+        if (max6675_read_many(&gs_group, raw, temp, status) != 0)
+        {
+            bad++;
+        }
+        for (j = 0; j < FANOUT_BENCHMARK_LINES; j++)
+        {
+            if ((status[j] != 0) || (raw[j] != 400 + j))
+            {
+                bad++;
+            }
+        }
+    }
+    sets = gs_sim.sets - sets;
+    max6675_interface_debug_print("fanout: batch %0.3f gpio set/sample.\n", (double)sets / samples);
+    
+    /* a group of cached frames is served without any transfer */
+    for (j = 0; j < FANOUT_BENCHMARK_LINES; j++)
+    {
+        (void)max6675_set_cache(&gs_handle[j], MAX6675_BOOL_TRUE);
+    }
+    (void)max6675_read_many(&gs_group, raw, temp, status);
+    sets = gs_sim.sets;
+    if (max6675_read_many(&gs_group, raw, temp, status) != 0)
+    {
+        bad++;
+    }
+    for (j = 0; j < FANOUT_BENCHMARK_LINES; j++)
+    {
+        if ((status[j] != 0) || (raw[j] != 400 + j))
+        {
+            bad++;
+        }
+        (void)max6675_set_cache(&gs_handle[j], MAX6675_BOOL_FALSE);
+    }
+    if (gs_sim.sets != sets)
+    {
+        bad++;
+    }
+    max6675_interface_debug_print("fanout: %d cs errors, %d bad frames.\n", gs_sim.errors, bad);
+    
+    /* deinit */
+    for (j = 0; j < FANOUT_BENCHMARK_LINES; j++)
+    {
+        (void)max6675_deinit(&gs_handle[j]);
+    }
+    (void)spi_fanout_deinit(&gs_fanout);
+    
+    return ((gs_sim.errors != 0) || (bad != 0)) ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      filter_benchmark.c
+ * @brief     filter benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "filter_benchmark.h"
+#include "driver_max6675_interface.h"
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief benchmark sample number definition
+ */
+#define FILTER_BENCHMARK_SAMPLES        (1024 * 1024)        /**< 1M samples */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_filter_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief     filter benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the cost of one update is printed for every filter type and every filter must keep the
+ *            mean of the input and reject a NULL output
+ */
+uint8_t filter_benchmark(uint32_t times)
+{
+    const struct
+    {
+        const char *name;
+        max6675_filter_type_t type;
+        uint8_t param;
+    } list[5] =
+    {
+        {"none", MAX6675_FILTER_TYPE_NONE, 0},
+        {"ema/4", MAX6675_FILTER_TYPE_EMA, 2},
+        {"boxcar/16", MAX6675_FILTER_TYPE_BOXCAR, 16},
+        {"median/5", MAX6675_FILTER_TYPE_MEDIAN, 5},
+        {"median/16", MAX6675_FILTER_TYPE_MEDIAN, 16},
+    };
+    max6675_filter_t filter;
+    uint16_t *raw;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t bad;
+    uint64_t sum;
+    uint16_t out;
+    
+    /* malloc the samples */
+    raw = (uint16_t *)malloc(FILTER_BENCHMARK_SAMPLES * sizeof(uint16_t));
+    if (raw == NULL)
+    {
+        max6675_interface_debug_print("filter: malloc failed.\n");
+        
+        return 1;
+    }
+    
+    /* make a noisy 100C signal */
+    srand(0);
+    for (i = 0; i < FILTER_BENCHMARK_SAMPLES; i++)
+    {
+        raw[i] = (uint16_t)(400 + (rand() % 17) - 8);
+    }
+    
+    /* run all filters */
+    bad = 0;
+    for (k = 0; k < sizeof(list) / sizeof(list[0]); k++)
+    {
+        double start;
+        double cost;
+        double mean;
+        
+        /* init the filter */
+        if (max6675_filter_init(&filter, list[k].type, list[k].param) != 0)
+        {
+            max6675_interface_debug_print("filter: init failed.\n");
+            free(raw);
+            
+            return 1;
+        }
+        
+        /* a NULL output must be rejected */
+        if (max6675_filter_update(&filter, raw[0], NULL) != 2)
+        {
+            max6675_interface_debug_print("filter: %s accepts a NULL output.\n", list[k].name);
+            bad++;
+        }
+        
+        /* run the filter */
+        sum = 0;
+        start = a_filter_benchmark_time();
+        for (j = 0; j < times; j++)
+        {
+            for (i = 0; i < FILTER_BENCHMARK_SAMPLES; i++)
+            {
+                (void)max6675_filter_update(&filter, raw[i], &out);
+                sum += out;
+            }
+        }
+        cost = a_filter_benchmark_time() - start;
+        mean = (double)sum * 0.25 / ((double)FILTER_BENCHMARK_SAMPLES * times);
+        
+        /* the noise is symmetric, so every filter must keep the 100C mean */
+        if ((mean < 99.75) || (mean > 100.25))
+        {
+            bad++;
+        }
+        
+        /* output */
+        max6675_interface_debug_print("filter: %s %0.2fns/sample, mean %0.2fC.\n", list[k].name,
+                                      cost * 1000000000.0 / ((double)FILTER_BENCHMARK_SAMPLES * times), mean);
+    }
+    max6675_interface_debug_print("filter: %u bad filters.\n", bad);
+    
+    /* free the samples */
+    free(raw);
+    
+    return (bad == 0) ? 0 : 1;
+}
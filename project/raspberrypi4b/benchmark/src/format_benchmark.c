@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      format_benchmark.c
+ * @brief     format benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "format_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include "raspberrypi4b_driver_max6675_format.h"
+#include <fcntl.h>
+#include <time.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define FORMAT_BENCHMARK_SAMPLES        1000000        /**< samples per round */
+
+/**
+ * @brief benchmark buffer definition
+ */
+static raspberrypi4b_max6675_format_t gs_format;                                  /**< formatter */
+static char gs_stdio_buf[RASPBERRYPI4B_MAX6675_FORMAT_BUFFER_SIZE];              /**< stdio buffer of the same size */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_format_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief      make a sample
+ * @param[in]  i sample index
+ * @param[out] *tick pointer to a tick buffer
+ * @param[out] *raw pointer to a raw buffer
+ * @param[out] *status pointer to a status buffer
+ * @note       a ramp over the whole range with a failed read every 97 samples
+ */
+static inline void a_format_benchmark_sample(uint32_t i, uint32_t *tick, uint16_t *raw, uint8_t *status)
+{
+    *tick = 1000000 + i * 250;
+    *raw = (uint16_t)((i * 7) & 0xFFF);
+    *status = ((i % 97) == 96) ? 1 : 0;
+}
+
+/**
+ * @brief     format benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      one million samples per round are written to /dev/null as csv with the buffered
+ *            fprintf path and with the integer formatter, the json lines are timed too and every
+ *            formatted line is compared with the printf text
+ */
+uint8_t format_benchmark(uint32_t times)
+{
+    char a[RASPBERRYPI4B_MAX6675_FORMAT_MAX_LINE];
+    char b[RASPBERRYPI4B_MAX6675_FORMAT_MAX_LINE];
+    uint32_t mismatch;
+    uint32_t round;
+    uint32_t tick;
+    uint32_t i;
+    uint16_t raw;
+    uint8_t status;
+    double t_printf;
+    double t_csv;
+    double t_json;
+    double t0;
+    FILE *fp;
+    int fd;
+    
+    t_printf = 0.0;
+    t_csv = 0.0;
+    t_json = 0.0;
+    mismatch = 0;
+    for (round = 0; round < times; round++)
+    {
+        /* the printf path */
+        fp = fopen("/dev/null", "w");
+        if (fp == NULL)
+        {
+            max6675_interface_debug_print("format: open /dev/null failed.\n");
+            
+            return 1;
+        }
+        (void)setvbuf(fp, gs_stdio_buf, _IOFBF, sizeof(gs_stdio_buf));
+        t0 = a_format_benchmark_time();
+        for (i = 0; i < FORMAT_BENCHMARK_SAMPLES; i++)
+        {
+            float temp;
+            
+            a_format_benchmark_sample(i, &tick, &raw, &status);
+            temp = (float)raw * 0.25f;
+            (void)fprintf(fp, "%u,%u,%0.2f,%d\n", tick, i & 3, (status != 0) ? 0.0f : temp, status);
+        }
+        (void)fclose(fp);
+        t_printf += a_format_benchmark_time() - t0;
+        
+        /* the integer formatter, csv and json */
+        for (fd = 0; fd < 2; fd++)
+        {
+            raspberrypi4b_max6675_format_type_t type;
+            
+            type = (fd == 0) ? RASPBERRYPI4B_MAX6675_FORMAT_CSV : RASPBERRYPI4B_MAX6675_FORMAT_JSON;
+            if (raspberrypi4b_max6675_format_open_fd(&gs_format, open("/dev/null", O_WRONLY | O_CLOEXEC), type) != 0)
+            {
+                max6675_interface_debug_print("format: open /dev/null failed.\n");
+                
+                return 1;
+            }
+            t0 = a_format_benchmark_time();
+            for (i = 0; i < FORMAT_BENCHMARK_SAMPLES; i++)
+            {
+                a_format_benchmark_sample(i, &tick, &raw, &status);
+                (void)raspberrypi4b_max6675_format_write(&gs_format, tick, (uint8_t)(i & 3), raw, status);
+            }
+            (void)raspberrypi4b_max6675_format_close(&gs_format);
+            if (fd == 0)
+            {
+                t_csv += a_format_benchmark_time() - t0;
+            }
+            else
+            {
+                t_json += a_format_benchmark_time() - t0;
+            }
+        }
+        
+        /* the same text as printf */
+        for (i = 0; i < FORMAT_BENCHMARK_SAMPLES; i++)
+        {
+            uint32_t len;
+            float temp;
+            
+            a_format_benchmark_sample(i, &tick, &raw, &status);
+            temp = (float)raw * 0.25f;
+            (void)snprintf(a, sizeof(a), "%u,%u,%0.2f,%d\n", tick, i & 3, (status != 0) ? 0.0f : temp, status);
+            len = raspberrypi4b_max6675_format_line(b, RASPBERRYPI4B_MAX6675_FORMAT_CSV, tick, (uint8_t)(i & 3), raw, status);
+            b[len] = '\0';
+            if (strcmp(a, b) != 0)
+            {
+                mismatch++;
+            }
+            if (status == 0)
+            {
+                (void)snprintf(a, sizeof(a), "{\"tick_ms\":%u,\"sensor\":%d,\"temperature_c\":%0.2f,\"status\":0}\n",
+                               tick, (int)(i & 3), temp);
+            }
+            else
+            {
+                (void)snprintf(a, sizeof(a), "{\"tick_ms\":%u,\"sensor\":%d,\"temperature_c\":null,\"status\":%d}\n",
+                               tick, (int)(i & 3), status);
+            }
+            len = raspberrypi4b_max6675_format_line(b, RASPBERRYPI4B_MAX6675_FORMAT_JSON, tick, (uint8_t)(i & 3), raw, status);
+            b[len] = '\0';
+            if (strcmp(a, b) != 0)
+            {
+                mismatch++;
+            }
+        }
+    }
+    
+    /* output */
+    t_printf = t_printf * 1000000000.0 / ((double)times * FORMAT_BENCHMARK_SAMPLES);
+    t_csv = t_csv * 1000000000.0 / ((double)times * FORMAT_BENCHMARK_SAMPLES);
+    t_json = t_json * 1000000000.0 / ((double)times * FORMAT_BENCHMARK_SAMPLES);
+    max6675_interface_debug_print("format: printf csv %0.1fns/sample.\n", t_printf);
+    max6675_interface_debug_print("format: integer csv %0.1fns/sample, x%0.1f.\n", t_csv, t_printf / t_csv);
+    max6675_interface_debug_print("format: integer json %0.1fns/sample.\n", t_json);
+    max6675_interface_debug_print("format: %d mismatches.\n", mismatch);
+    
+    return 0;
+}
@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      history_benchmark.c
+ * @brief     history benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "history_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include "raspberrypi4b_driver_max6675_history.h"
+#include <fcntl.h>
+#include <stdlib.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define HISTORY_BENCHMARK_SAMPLES          1000000        /**< samples per round */
+#define HISTORY_BENCHMARK_PERIOD_MS        250            /**< sample period */
+#define HISTORY_BENCHMARK_THRESHOLD        (220 * 4)      /**< scanned raw threshold */
+
+/**
+ * @brief benchmark buffer definition
+ */
+static raspberrypi4b_max6675_history_writer_t gs_writer;                       /**< writer */
+static uint32_t gs_tick[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES];          /**< decoded ticks */
+static uint16_t gs_raw[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES];           /**< decoded raws */
+static uint8_t gs_status[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES];         /**< decoded status */
+
+/**
+ * @brief     mix a sample into a checksum
+ * @param[in] sum checksum
+ * @param[in] tick tick in ms
+ * @param[in] raw raw temperature
+ * @param[in] status status code
+ * @return    checksum
+ * @note      fnv-1a over the sample fields
+ */
+static uint64_t a_history_mix(uint64_t sum, uint32_t tick, uint16_t raw, uint8_t status)
+{
+    uint64_t v = ((uint64_t)tick << 24) | ((uint64_t)raw << 8) | status;
+    uint32_t i;
+    
+    for (i = 0; i < 8; i++)
+    {
+        sum ^= (v >> (i * 8)) & 0xFF;
+        sum *= 1099511628211ULL;
+    }
+    
+    return sum;
+}
+
+/**
+ * @brief     history benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      one million simulated samples per round are written to a temporary history, the
+ *            size is compared with the text log, the history is decoded and checked and a range
+ *            scan skips the chunks by their headers, at last a torn tail is added and must be cut
+ *            by the next open
+ */
+uint8_t history_benchmark(uint32_t times)
+{
+    char path[] = "/tmp/max6675_history_XXXXXX";
+    char line[64];
+    raspberrypi4b_max6675_sim_t sim;
+    raspberrypi4b_max6675_history_reader_t reader;
+    raspberrypi4b_max6675_history_chunk_t chunk;
+    const uint8_t *payload;
+    uint64_t text;
+    uint64_t sum;
+    uint64_t check;
+    uint64_t count;
+    uint64_t total;
+    uint64_t start;
+    uint32_t chunks;
+    uint32_t skipped;
+    uint32_t hits;
+    uint32_t bad;
+    uint32_t i;
+    uint32_t j;
+    int fd;
+    double s;
+    
+    /* a day cycle with noise and a short open input */
+    fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("history: mkstemp failed");
+        
+        return 1;
+    }
+    (void)close(fd);
+    if (raspberrypi4b_max6675_history_open(&gs_writer, path) != 0)
+    {
+        (void)unlink(path);
+        
+        return 1;
+    }
+    raspberrypi4b_max6675_sim_set_virtual_clock(1);
+    (void)raspberrypi4b_max6675_sim_init(&sim, 6675);
+    sim.wave = RASPBERRYPI4B_MAX6675_SIM_WAVE_SINE;
+    sim.base = 200.0f;
+    sim.amplitude = 25.0f;
+    sim.period_ms = 6 * 3600 * 1000;
+    sim.noise = 0.25f;
+    
+    /* write */
+    text = 0;
+    sum = 14695981039346656037ULL;
+    bad = 0;
+    for (i = 0; i < times; i++)
+    {
+        for (j = 0; j < HISTORY_BENCHMARK_SAMPLES; j++)
+        {
+            uint8_t buf[2];
+            uint16_t frame;
+            uint16_t raw;
+            uint8_t status;
+            uint32_t tick;
+            
+            raspberrypi4b_max6675_sim_delay_ms(HISTORY_BENCHMARK_PERIOD_MS);
+            sim.open = ((j % 100000) < 20) ? 1 : 0;
+            (void)raspberrypi4b_max6675_sim_spi_read_cmd(&sim, buf, 2);
+            frame = (uint16_t)((buf[0] << 8) | buf[1]);
+            raw = frame >> 3;
+            status = ((frame & 0x04) != 0) ? 4 : 0;
+            tick = raspberrypi4b_max6675_sim_get_tick_ms();
+            if (raspberrypi4b_max6675_history_write(&gs_writer, tick, raw, status) != 0)
+            {
+                bad++;
+            }
+            sum = a_history_mix(sum, tick, raw, status);
+            text += (uint64_t)snprintf(line, sizeof(line), "max6675: temperature is %0.2fC.\n", raw * 0.25f);
+        }
+    }
+    raspberrypi4b_max6675_sim_set_virtual_clock(0);
+    if (raspberrypi4b_max6675_history_close(&gs_writer) != 0)
+    {
+        bad++;
+    }
+    max6675_interface_debug_print("history: %0.2f bytes/sample, text %0.2f bytes/sample, %0.1fx smaller.\n",
+                                  (double)gs_writer.bytes / gs_writer.samples, (double)text / gs_writer.samples,
+                                  (double)text / gs_writer.bytes);
+    
+    /* decode every chunk and check it */
+    if (raspberrypi4b_max6675_history_reader_open(&reader, path) != 0)
+    {
+        (void)unlink(path);
+        
+        return 1;
+    }
+    check = 14695981039346656037ULL;
+    count = 0;
+    chunks = 0;
+    while (raspberrypi4b_max6675_history_reader_next(&reader, &chunk, &payload) == 0)
+    {
+        if (raspberrypi4b_max6675_history_decode(&chunk, payload, gs_tick, gs_raw, gs_status) != 0)
+        {
+            bad++;
+        }
+        for (j = 0; j < chunk.count; j++)
+        {
+            check = a_history_mix(check, gs_tick[j], gs_raw[j], gs_status[j]);
+        }
+        count += chunk.count;
+        chunks++;
+    }
+    if ((check != sum) || (count != gs_writer.samples))
+    {
+        bad++;
+    }
+    
+    /* time the decode alone */
+    raspberrypi4b_max6675_history_reader_rewind(&reader);
+    hits = 0;
+    start = periodic_now_ns();
+    while (raspberrypi4b_max6675_history_reader_next(&reader, &chunk, &payload) == 0)
+    {
+        (void)raspberrypi4b_max6675_history_decode(&chunk, payload, gs_tick, gs_raw, gs_status);
+        hits += gs_raw[chunk.count - 1];
+    }
+    s = (double)(periodic_now_ns() - start) / 1000000000.0;
+    max6675_interface_debug_print("history: decode %0.1f Msamples/s, %0.1f MB/s.\n",
+                                  count / s / 1000000.0, reader.size / s / 1000000.0);
+    
+    /* find the hot samples and skip the chunks by their max */
+    raspberrypi4b_max6675_history_reader_rewind(&reader);
+    skipped = 0;
+    hits = 0;
+    while (raspberrypi4b_max6675_history_reader_next(&reader, &chunk, &payload) == 0)
+    {
+        if (chunk.max < HISTORY_BENCHMARK_THRESHOLD)
+        {
+            skipped++;
+            
+            continue;
+        }
+        (void)raspberrypi4b_max6675_history_decode(&chunk, payload, gs_tick, gs_raw, gs_status);
+        for (j = 0; j < chunk.count; j++)
+        {
+            hits += ((gs_status[j] == 0) && (gs_raw[j] >= HISTORY_BENCHMARK_THRESHOLD)) ? 1 : 0;
+        }
+    }
+    max6675_interface_debug_print("history: %u hot samples, %u of %u chunks skipped.\n", hits, skipped, chunks);
+    (void)raspberrypi4b_max6675_history_reader_close(&reader);
+    
+    /* tear the tail with a chunk header whose payload is cut, reopen and append */
+    total = count;
+    memset(line, 0, sizeof(line));
+    line[0] = 100;
+    line[4] = 1;
+    fd = open(path, O_WRONLY | O_APPEND);
+    if ((fd < 0) || (write(fd, line, RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE + 5) < 0))
+    {
+        bad++;
+    }
+    if (fd >= 0)
+    {
+        (void)close(fd);
+    }
+    if ((raspberrypi4b_max6675_history_open(&gs_writer, path) != 0) ||
+        (raspberrypi4b_max6675_history_write(&gs_writer, 0, 400, 0) != 0) ||
+        (raspberrypi4b_max6675_history_close(&gs_writer) != 0))
+    {
+        bad++;
+    }
+    
+    /* every old sample and the new one must be read back */
+    if (raspberrypi4b_max6675_history_reader_open(&reader, path) != 0)
+    {
+        (void)unlink(path);
+        
+        return 1;
+    }
+    count = 0;
+    while (raspberrypi4b_max6675_history_reader_next(&reader, &chunk, &payload) == 0)
+    {
+        count += chunk.count;
+    }
+    if ((count != total + 1) || (reader.off != reader.size))
+    {
+        max6675_interface_debug_print("history: %llu of %llu samples after the torn tail.\n",
+                                      (unsigned long long)count, (unsigned long long)(total + 1));
+        bad++;
+    }
+    max6675_interface_debug_print("history: %u bad samples.\n", bad);
+    (void)raspberrypi4b_max6675_history_reader_close(&reader);
+    (void)unlink(path);
+    
+    return (bad != 0) ? 1 : 0;
+}
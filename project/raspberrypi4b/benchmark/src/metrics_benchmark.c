@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      metrics_benchmark.c
+ * @brief     metrics benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "metrics_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include "raspberrypi4b_driver_max6675_metrics.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <time.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define METRICS_BENCHMARK_SENSORS         4          /**< exposed sensors */
+#define METRICS_BENCHMARK_ROUND_MS        100        /**< run time of one round */
+
+/**
+ * @brief benchmark buffer definition
+ */
+static raspberrypi4b_max6675_metrics_t gs_metrics;        /**< metrics */
+static char gs_response[RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE];        /**< scraped response */
+static volatile uint8_t gs_running;                      /**< scraper runs while set */
+static uint32_t gs_scrapes;                              /**< finished scrapes */
+static uint32_t gs_bad;                                  /**< bad responses */
+static uint64_t gs_total_ns;                             /**< scrape time sum */
+static uint64_t gs_max_ns;                               /**< longest scrape */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_metrics_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief      get one path
+ * @param[in]  *path pointer to a request path
+ * @param[out] *len pointer to a response length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the response is read into gs_response until the server closes the connection
+ */
+static uint8_t a_metrics_benchmark_get(const char *path, uint32_t *len)
+{
+    struct sockaddr_in addr;
+    char request[64];
+    int n;
+    int fd;
+    
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(gs_metrics.port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    n = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: localhost\r\n\r\n", path);
+    if (send(fd, request, (size_t)n, MSG_NOSIGNAL) != n)
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    *len = 0;
+    while (*len < sizeof(gs_response) - 1)
+    {
+        ssize_t r;
+        
+        r = read(fd, gs_response + *len, sizeof(gs_response) - 1 - *len);
+        if (r <= 0)
+        {
+            break;
+        }
+        *len += (uint32_t)r;
+    }
+    gs_response[*len] = '\0';
+    (void)close(fd);
+    
+    return 0;
+}
+
+/**
+ * @brief     check a metrics response
+ * @param[in] len response length
+ * @return    1 if the response is good, else 0
+ * @note      the header must match the body, the body must end with # EOF and the reads of every
+ *            sensor must equal its histogram count, which only holds for a response rendered at once
+ */
+static uint8_t a_metrics_benchmark_check(uint32_t len)
+{
+    const char *body;
+    const char *p;
+    unsigned long content;
+    unsigned long long reads;
+    unsigned long long count;
+    char key[64];
+    uint32_t i;
+    
+    if (strncmp(gs_response, "HTTP/1.1 200 OK\r\n", 17) != 0)
+    {
+        return 0;
+    }
+    p = strstr(gs_response, "Content-Length: ");
+    body = strstr(gs_response, "\r\n\r\n");
+    if ((p == NULL) || (body == NULL) || (strstr(gs_response, "application/openmetrics-text") == NULL))
+    {
+        return 0;
+    }
+    body += 4;
+    content = strtoul(p + 16, NULL, 10);
+    if ((content != (unsigned long)(gs_response + len - body)) || (content < 6) ||
+        (strcmp(gs_response + len - 6, "# EOF\n") != 0))
+    {
+        return 0;
+    }
+    for (i = 0; i < METRICS_BENCHMARK_SENSORS; i++)
+    {
+        (void)snprintf(key, sizeof(key), "max6675_reads_total{sensor=\"%u\"} ", i);
+        p = strstr(body, key);
+        if (p == NULL)
+        {
+            return 0;
+        }
+        reads = strtoull(p + strlen(key), NULL, 10);
+        (void)snprintf(key, sizeof(key), "max6675_read_latency_seconds_count{sensor=\"%u\"} ", i);
+        p = strstr(body, key);
+        if (p == NULL)
+        {
+            return 0;
+        }
+        count = strtoull(p + strlen(key), NULL, 10);
+        if (reads != count)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     scraper thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      an unknown path must get 404 once, then /metrics is scraped until the end
+ */
+static void *a_metrics_benchmark_scraper(void *arg)
+{
+    uint32_t len;
+    
+    (void)arg;
+    if ((a_metrics_benchmark_get("/", &len) != 0) || (strncmp(gs_response, "HTTP/1.1 404 ", 13) != 0))
+    {
+        gs_bad++;
+    }
+    while (__atomic_load_n(&gs_running, __ATOMIC_RELAXED) != 0)
+    {
+        double t0;
+        uint64_t ns;
+        
+        t0 = a_metrics_benchmark_time();
+        if ((a_metrics_benchmark_get("/metrics", &len) != 0) || (a_metrics_benchmark_check(len) == 0))
+        {
+            gs_bad++;
+        }
+        ns = (uint64_t)((a_metrics_benchmark_time() - t0) * 1000000000.0);
+        gs_total_ns += ns;
+        if (ns > gs_max_ns)
+        {
+            gs_max_ns = ns;
+        }
+        gs_scrapes++;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     metrics benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      a scraper thread gets http://127.0.0.1/metrics over and over while the sensors are
+ *            updated, every response is checked as a whole, more renders than scrapes are bad and
+ *            the scrape time is reported
+ */
+uint8_t metrics_benchmark(uint32_t times)
+{
+    pthread_t thread;
+    max6675_stats_t stats;
+    uint32_t updates;
+    double update;
+    double t0;
+    double t1;
+    
+    /* a free port on the loopback */
+    if (raspberrypi4b_max6675_metrics_open(&gs_metrics, "127.0.0.1", 0, METRICS_BENCHMARK_SENSORS) != 0)
+    {
+        max6675_interface_debug_print("metrics: open failed.\n");
+        
+        return 1;
+    }
+    gs_running = 1;
+    gs_scrapes = 0;
+    gs_bad = 0;
+    gs_total_ns = 0;
+    gs_max_ns = 0;
+    if (pthread_create(&thread, NULL, a_metrics_benchmark_scraper, NULL) != 0)
+    {
+        max6675_interface_debug_print("metrics: thread create failed.\n");
+        (void)raspberrypi4b_max6675_metrics_close(&gs_metrics);
+        
+        return 1;
+    }
+    
+    /* update the sensors and serve between the updates */
+    memset(&stats, 0, sizeof(stats));
+    updates = 0;
+    update = 0.0;
+    t0 = a_metrics_benchmark_time();
+    t1 = t0;
+    while (t1 - t0 < (double)times * METRICS_BENCHMARK_ROUND_MS / 1000.0)
+    {
+        uint8_t status;
+        double s;
+        
+        status = ((updates % 50) == 49) ? 4 : 0;
+        if (status == 4)
+        {
+            stats.open++;
+        }
+        s = a_metrics_benchmark_time();
+        (void)raspberrypi4b_max6675_metrics_update(&gs_metrics, updates % METRICS_BENCHMARK_SENSORS,
+                                                   (uint16_t)(100 + updates % 8), status,
+                                                   20000 + (updates % 1000) * 1000, &stats);
+        update += a_metrics_benchmark_time() - s;
+        updates++;
+        (void)raspberrypi4b_max6675_metrics_poll(&gs_metrics, 1);
+        t1 = a_metrics_benchmark_time();
+    }
+    
+    /* stop the scraper, its last scrape is still served */
+    __atomic_store_n(&gs_running, 0, __ATOMIC_RELAXED);
+    while (pthread_tryjoin_np(thread, NULL) != 0)
+    {
+        (void)raspberrypi4b_max6675_metrics_poll(&gs_metrics, 1);
+    }
+    (void)raspberrypi4b_max6675_metrics_close(&gs_metrics);
+    
+    /* one render at open and at most one per scrape */
+    if (gs_metrics.renders > gs_metrics.scrapes + 1)
+    {
+        gs_bad++;
+    }
+    
+    /* output */
+    max6675_interface_debug_print("metrics: %d updates, %0.2fus per update.\n",
+                                  updates, (updates != 0) ? update * 1000000.0 / updates : 0.0);
+    max6675_interface_debug_print("metrics: %d renders of %d bytes.\n", gs_metrics.renders, gs_metrics.len);
+    max6675_interface_debug_print("metrics: %d scrapes, %0.1fus mean, %0.1fus max.\n", gs_scrapes,
+                                  (gs_scrapes != 0) ? (double)gs_total_ns / gs_scrapes / 1000.0 : 0.0,
+                                  (double)gs_max_ns / 1000.0);
+    max6675_interface_debug_print("metrics: %d bad responses.\n", gs_bad);
+    
+    return 0;
+}
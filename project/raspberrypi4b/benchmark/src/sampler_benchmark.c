@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sampler_benchmark.c
+ * @brief     sampler benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sampler_benchmark.h"
+#include "raspberrypi4b_driver_max6675_sampler.h"
+#include <errno.h>
+#include <time.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define SAMPLER_BENCHMARK_DEVICES         2           /**< devices on one controller */
+#define SAMPLER_BENCHMARK_FRAME_US        1000        /**< simulated transfer time of one frame */
+#define SAMPLER_BENCHMARK_ROUND_MS        100         /**< run time of one round */
+#define SAMPLER_BENCHMARK_QUEUE           1024        /**< queue cells */
+#define SAMPLER_BENCHMARK_FLOOR           0.50        /**< lowest allowed bus usage */
+
+/**
+ * @brief simulated controller locks definition
+ */
+static pthread_mutex_t gs_bus_mutex[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS] =
+{
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+};                                                                   /**< one fd per controller */
+static uint64_t gs_bus_free_ns[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS];   /**< end of the last transfer of each controller */
+
+/**
+ * @brief benchmark buffer definition
+ */
+static char gs_name[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS * SAMPLER_BENCHMARK_DEVICES][32];                  /**< device names */
+static raspberrypi4b_max6675_device_t gs_device[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS * SAMPLER_BENCHMARK_DEVICES];  /**< devices */
+static max6675_handle_t gs_handle[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS * SAMPLER_BENCHMARK_DEVICES];       /**< handles */
+static max6675_handle_t *gs_handle_list[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS * SAMPLER_BENCHMARK_DEVICES]; /**< handle list */
+static raspberrypi4b_max6675_sampler_cell_t gs_cell[SAMPLER_BENCHMARK_QUEUE];                              /**< queue cells */
+static raspberrypi4b_max6675_sampler_t gs_sampler;                                                         /**< sampler */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_sampler_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief     simulated spi init
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 device
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the controller number is kept in fd
+ */
+static uint8_t a_sampler_benchmark_spi_init(void *ctx)
+{
+    raspberrypi4b_max6675_device_t *dev = (raspberrypi4b_max6675_device_t *)ctx;
+    unsigned int b;
+    unsigned int c;
+    
+    if (sscanf(dev->name, "/dev/spidev%u.%u", &b, &c) != 2)
+    {
+        return 1;
+    }
+    dev->fd = (int)b;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulated spi deinit
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 device
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sampler_benchmark_spi_deinit(void *ctx)
+{
+    ((raspberrypi4b_max6675_device_t *)ctx)->fd = -1;
+    
+    return 0;
+}
+
+/**
+ * @brief      simulated spi read
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 device
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       every transfer reserves SAMPLER_BENCHMARK_FRAME_US of its controller after the last
+ *             one and returns 25.00C when the reserved time is over, so one controller never
+ *             does more than one frame per SAMPLER_BENCHMARK_FRAME_US however late a thread wakes
+ */
+static uint8_t a_sampler_benchmark_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_max6675_device_t *dev = (raspberrypi4b_max6675_device_t *)ctx;
+    struct timespec t;
+    uint64_t now;
+    uint64_t end;
+    
+    /* reserve the transfer time of the controller */
+    (void)pthread_mutex_lock(&gs_bus_mutex[dev->fd]);
+    now = periodic_now_ns();
+    end = (gs_bus_free_ns[dev->fd] > now) ? gs_bus_free_ns[dev->fd] : now;
+    end += SAMPLER_BENCHMARK_FRAME_US * 1000ULL;
+    gs_bus_free_ns[dev->fd] = end;
+    (void)pthread_mutex_unlock(&gs_bus_mutex[dev->fd]);
+    
+    /* wait for the end of the transfer */
+    t.tv_sec = (time_t)(end / 1000000000ULL);
+    t.tv_nsec = (long)(end % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR)
+    {
+        /* sleep again after a signal */
+    }
+    memset(buf, 0, len);
+    buf[0] = (100 << 3) >> 8;
+    buf[1] = (100 << 3) & 0xFF;
+    
+    return 0;
+}
+
+/**
+ * @brief     run the sampler on simulated controllers
+ * @param[in] buses controller number
+ * @param[in] times benchmark rounds
+ * @param[out] *rate pointer to a samples per second buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_sampler_benchmark_run(uint8_t buses, uint32_t times, double *rate)
+{
+    raspberrypi4b_max6675_sample_t sample;
+    uint64_t samples;
+    uint32_t dropped;
+    uint16_t num;
+    uint16_t i;
+    double t0;
+    double t1;
+    
+    /* link the simulated devices on idle controllers */
+    memset(gs_bus_free_ns, 0, sizeof(gs_bus_free_ns));
+    num = buses * SAMPLER_BENCHMARK_DEVICES;
+    for (i = 0; i < num; i++)
+    {
+        (void)snprintf(gs_name[i], 32, "/dev/spidev%d.%d", i / SAMPLER_BENCHMARK_DEVICES, i % SAMPLER_BENCHMARK_DEVICES);
+        RASPBERRYPI4B_MAX6675_DEVICE_INIT(&gs_device[i], gs_name[i]);
+        DRIVER_MAX6675_LINK_INIT(&gs_handle[i], max6675_handle_t);
+        DRIVER_MAX6675_LINK_SPI_INIT(&gs_handle[i], a_sampler_benchmark_spi_init);
+        DRIVER_MAX6675_LINK_SPI_DEINIT(&gs_handle[i], a_sampler_benchmark_spi_deinit);
+        DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&gs_handle[i], a_sampler_benchmark_spi_read_cmd);
+        DRIVER_MAX6675_LINK_CONTEXT(&gs_handle[i], &gs_device[i]);
+        DRIVER_MAX6675_LINK_DELAY_MS(&gs_handle[i], max6675_interface_delay_ms);
+        DRIVER_MAX6675_LINK_GET_TICK_MS(&gs_handle[i], max6675_interface_get_tick_ms);
+        DRIVER_MAX6675_LINK_DEBUG_PRINT(&gs_handle[i], max6675_interface_debug_print);
+        if (max6675_init(&gs_handle[i]) != 0)
+        {
+            max6675_interface_debug_print("sampler: init failed.\n");
+            
+            return 1;
+        }
+        gs_handle_list[i] = &gs_handle[i];
+    }
+    if (raspberrypi4b_max6675_sampler_init(&gs_sampler, gs_handle_list, num, gs_cell, SAMPLER_BENCHMARK_QUEUE) != 0)
+    {
+        max6675_interface_debug_print("sampler: sampler init failed.\n");
+        
+        return 1;
+    }
+    
+    /* consume until the run time is over */
+    samples = 0;
+    t0 = a_sampler_benchmark_time();
+    if (raspberrypi4b_max6675_sampler_start(&gs_sampler, 0) != 0)
+    {
+        max6675_interface_debug_print("sampler: start failed.\n");
+        
+        return 1;
+    }
+    while (a_sampler_benchmark_time() - t0 < (double)times * SAMPLER_BENCHMARK_ROUND_MS / 1000.0)
+    {
+        if (raspberrypi4b_max6675_sampler_pop(&gs_sampler, &sample) == 0)
+        {
+            samples++;
+        }
+        else
+        {
+            usleep(100);
+        }
+    }
+    (void)raspberrypi4b_max6675_sampler_stop(&gs_sampler);
+    t1 = a_sampler_benchmark_time();
+    while (raspberrypi4b_max6675_sampler_pop(&gs_sampler, &sample) == 0)
+    {
+        samples++;
+    }
+    (void)raspberrypi4b_max6675_sampler_get_dropped(&gs_sampler, &dropped);
+    for (i = 0; i < num; i++)
+    {
+        (void)max6675_deinit(&gs_handle[i]);
+    }
+    *rate = (double)(samples + dropped) / (t1 - t0);
+    max6675_interface_debug_print("sampler: %u bus %u devices %0.1f samples/s, %u dropped.\n",
+                                  buses, num, *rate, dropped);
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      simulated devices are read on 1, 2 and 4 controllers and the aggregate samples
+ *            per second are printed, no spi hardware is used, the scaling is the rate over the
+ *            frame rate of one controller, so n independent controllers must scale at most n
+ *            times and at least SAMPLER_BENCHMARK_FLOOR times n
+ */
+uint8_t sampler_benchmark(uint32_t times)
+{
+    const uint8_t buses[3] = {1, 2, 4};
+    uint32_t bad;
+    double rate;
+    double scaling;
+    uint8_t i;
+    
+    bad = 0;
+    for (i = 0; i < 3; i++)
+    {
+        if (a_sampler_benchmark_run(buses[i], times, &rate) != 0)
+        {
+            return 1;
+        }
+        scaling = rate * SAMPLER_BENCHMARK_FRAME_US / 1000000.0;
+        
+        /* more than linear is a shared bus model, less than the floor is a serialized sampler */
+        if ((scaling > buses[i]) || (scaling < buses[i] * SAMPLER_BENCHMARK_FLOOR))
+        {
+            bad++;
+        }
+        max6675_interface_debug_print("sampler: scaling x%0.2f of x%u.\n", scaling, buses[i]);
+    }
+    max6675_interface_debug_print("sampler: %u bad runs.\n", bad);
+    
+    return (bad == 0) ? 0 : 1;
+}
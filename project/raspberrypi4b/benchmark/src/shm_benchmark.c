@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm_benchmark.c
+ * @brief     shm benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "shm_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include "raspberrypi4b_driver_max6675_shm.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <time.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define SHM_BENCHMARK_SENSORS         16         /**< published sensors */
+#define SHM_BENCHMARK_READERS         3          /**< reader threads */
+#define SHM_BENCHMARK_ROUND_MS        100        /**< run time of one round */
+
+/**
+ * @brief shm benchmark reader structure definition
+ */
+typedef struct shm_benchmark_reader_s
+{
+    pthread_t thread;                       /**< reader thread */
+    raspberrypi4b_max6675_shm_t shm;        /**< own mapping */
+    uint64_t reads;                         /**< snapshots read */
+    uint64_t busy;                          /**< reads that gave up retrying */
+    uint64_t torn;                          /**< inconsistent snapshots */
+} shm_benchmark_reader_t;
+
+/**
+ * @brief benchmark buffer definition
+ */
+static raspberrypi4b_max6675_shm_t gs_publisher;                              /**< publisher mapping */
+static shm_benchmark_reader_t gs_reader[SHM_BENCHMARK_READERS];              /**< readers */
+static volatile uint8_t gs_running;                                          /**< readers run while set */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_shm_benchmark_time(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (double)t.tv_sec + (double)t.tv_nsec / 1000000000.0;
+}
+
+/**
+ * @brief     reader thread
+ * @param[in] *arg pointer to a shm benchmark reader structure
+ * @return    NULL
+ * @note      the publisher writes sample i to sensor i % SHM_BENCHMARK_SENSORS with the tick i, so
+ *            every field of a snapshot follows from its tick and the count never goes back
+ */
+static void *a_shm_benchmark_reader(void *arg)
+{
+    shm_benchmark_reader_t *reader = (shm_benchmark_reader_t *)arg;
+    raspberrypi4b_max6675_shm_sample_t sample;
+    uint32_t last[SHM_BENCHMARK_SENSORS] = {0};
+    uint32_t i;
+    
+    i = 0;
+    while (__atomic_load_n(&gs_running, __ATOMIC_RELAXED) != 0)
+    {
+        uint8_t res;
+        
+        res = raspberrypi4b_max6675_shm_read(&reader->shm, i, &sample);
+        if (res == 4)
+        {
+            reader->busy++;
+        }
+        else if (res != 0)
+        {
+            reader->torn++;
+        }
+        else if (sample.count != 0)
+        {
+            if ((sample.tick % SHM_BENCHMARK_SENSORS != i) ||
+                (sample.count != sample.tick / SHM_BENCHMARK_SENSORS + 1) ||
+                (sample.raw != ((sample.tick * 7) & 0xFFF)) ||
+                (sample.status != (sample.tick & 1)) ||
+                (sample.temp != (int32_t)sample.raw * 25) ||
+                (sample.count < last[i]))
+            {
+                reader->torn++;
+            }
+            last[i] = sample.count;
+        }
+        else
+        {
+            /* not published yet */
+        }
+        reader->reads++;
+        i = (i + 1) % SHM_BENCHMARK_SENSORS;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     shm benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      one publisher thread rewrites a temporary segment as fast as it can while reader
+ *            threads with their own mappings check every snapshot for torn fields
+ */
+uint8_t shm_benchmark(uint32_t times)
+{
+    char name[64];
+    uint64_t reads;
+    uint64_t busy;
+    uint64_t torn;
+    uint32_t tick;
+    uint32_t i;
+    double t0;
+    double t1;
+    
+    /* a private segment */
+    (void)snprintf(name, sizeof(name), "/max6675_benchmark_%d", (int)getpid());
+    (void)shm_unlink(name);
+    if (raspberrypi4b_max6675_shm_create(&gs_publisher, name, SHM_BENCHMARK_SENSORS) != 0)
+    {
+        max6675_interface_debug_print("shm: create failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < SHM_BENCHMARK_READERS; i++)
+    {
+        memset(&gs_reader[i], 0, sizeof(shm_benchmark_reader_t));
+        if (raspberrypi4b_max6675_shm_open(&gs_reader[i].shm, name) != 0)
+        {
+            max6675_interface_debug_print("shm: open failed.\n");
+            while (i > 0)
+            {
+                i--;
+                (void)raspberrypi4b_max6675_shm_close(&gs_reader[i].shm);
+            }
+            (void)raspberrypi4b_max6675_shm_close(&gs_publisher);
+            (void)shm_unlink(name);
+            
+            return 1;
+        }
+    }
+    
+    /* start the readers */
+    gs_running = 1;
+    for (i = 0; i < SHM_BENCHMARK_READERS; i++)
+    {
+        if (pthread_create(&gs_reader[i].thread, NULL, a_shm_benchmark_reader, &gs_reader[i]) != 0)
+        {
+            max6675_interface_debug_print("shm: thread create failed.\n");
+            __atomic_store_n(&gs_running, 0, __ATOMIC_RELAXED);
+            while (i > 0)
+            {
+                i--;
+                (void)pthread_join(gs_reader[i].thread, NULL);
+            }
+            
+            break;
+        }
+    }
+    
+    /* publish until the run time is over */
+    tick = 0;
+    t0 = a_shm_benchmark_time();
+    t1 = t0;
+    while ((__atomic_load_n(&gs_running, __ATOMIC_RELAXED) != 0) &&
+           (t1 - t0 < (double)times * SHM_BENCHMARK_ROUND_MS / 1000.0))
+    {
+        for (i = 0; i < 4096; i++)
+        {
+            (void)raspberrypi4b_max6675_shm_publish(&gs_publisher, tick % SHM_BENCHMARK_SENSORS, tick,
+                                                    (uint16_t)((tick * 7) & 0xFFF), (uint8_t)(tick & 1));
+            tick++;
+        }
+        t1 = a_shm_benchmark_time();
+    }
+    
+    /* stop the readers */
+    reads = 0;
+    busy = 0;
+    torn = 0;
+    if (__atomic_load_n(&gs_running, __ATOMIC_RELAXED) != 0)
+    {
+        __atomic_store_n(&gs_running, 0, __ATOMIC_RELAXED);
+        for (i = 0; i < SHM_BENCHMARK_READERS; i++)
+        {
+            (void)pthread_join(gs_reader[i].thread, NULL);
+            reads += gs_reader[i].reads;
+            busy += gs_reader[i].busy;
+            torn += gs_reader[i].torn;
+        }
+    }
+    else
+    {
+        torn = 1;
+    }
+    for (i = 0; i < SHM_BENCHMARK_READERS; i++)
+    {
+        (void)raspberrypi4b_max6675_shm_close(&gs_reader[i].shm);
+    }
+    (void)raspberrypi4b_max6675_shm_close(&gs_publisher);
+    (void)shm_unlink(name);
+    
+    /* output */
+    max6675_interface_debug_print("shm: publish %0.1f Msamples/s.\n", (double)tick / (t1 - t0) / 1000000.0);
+    max6675_interface_debug_print("shm: %d readers %0.1f Msnapshots/s, %llu gave up retrying.\n", SHM_BENCHMARK_READERS,
+                                  (double)reads / (t1 - t0) / 1000000.0, (unsigned long long)busy);
+    max6675_interface_debug_print("shm: %llu torn snapshots.\n", (unsigned long long)torn);
+    
+    return 0;
+}
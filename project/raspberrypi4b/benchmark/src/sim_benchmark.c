@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sim_benchmark.c
+ * @brief     sim benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sim_benchmark.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include <math.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define SIM_BENCHMARK_SENSORS        4096        /**< simulated thermocouples */
+#define SIM_BENCHMARK_PERIOD_MS      250         /**< sample period */
+#define SIM_BENCHMARK_NOISE          0.5f        /**< noise standard deviation in C */
+
+/**
+ * @brief benchmark buffer definition
+ */
+static raspberrypi4b_max6675_sim_t gs_sim[SIM_BENCHMARK_SENSORS];                 /**< simulators */
+static max6675_handle_t gs_handle[SIM_BENCHMARK_SENSORS];                         /**< handles */
+
+/**
+ * @brief     sim benchmark
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      thousands of simulated chips with waveforms, noise, open inputs and injected
+ *            failures are read through the driver on the virtual clock, the read rate is
+ *            printed and every status and temperature is checked against the simulators,
+ *            a sub-zero junction must read 0C with the default stuck low check
+ */
+uint8_t sim_benchmark(uint32_t times)
+{
+    uint32_t count[7];
+    uint16_t raw[2];
+    float temp;
+    uint32_t fails;
+    uint32_t corrupts;
+    uint32_t bad;
+    uint32_t i;
+    uint32_t j;
+    uint64_t start;
+    double s;
+    
+    /* a mix of waveforms, every 64th input is open */
+    raspberrypi4b_max6675_sim_set_virtual_clock(1);
+    for (j = 0; j < SIM_BENCHMARK_SENSORS; j++)
+    {
+        (void)raspberrypi4b_max6675_sim_init(&gs_sim[j], j + 1);
+        gs_sim[j].wave = (raspberrypi4b_max6675_sim_wave_t)(j % 4);
+        gs_sim[j].base = 60.0f + (float)(j % 200);
+        gs_sim[j].amplitude = 50.0f;
+        gs_sim[j].period_ms = 10000 + j;
+        gs_sim[j].noise = SIM_BENCHMARK_NOISE;
+        gs_sim[j].open = ((j % 64) == 63) ? 1 : 0;
+        DRIVER_MAX6675_LINK_INIT(&gs_handle[j], max6675_handle_t);
+        DRIVER_MAX6675_LINK_SPI_INIT(&gs_handle[j], raspberrypi4b_max6675_sim_spi_init);
+        DRIVER_MAX6675_LINK_SPI_DEINIT(&gs_handle[j], raspberrypi4b_max6675_sim_spi_deinit);
+        DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&gs_handle[j], raspberrypi4b_max6675_sim_spi_read_cmd);
+        DRIVER_MAX6675_LINK_CONTEXT(&gs_handle[j], &gs_sim[j]);
+        DRIVER_MAX6675_LINK_DELAY_MS(&gs_handle[j], raspberrypi4b_max6675_sim_delay_ms);
+        DRIVER_MAX6675_LINK_GET_TICK_MS(&gs_handle[j], raspberrypi4b_max6675_sim_get_tick_ms);
+        DRIVER_MAX6675_LINK_DEBUG_PRINT(&gs_handle[j], max6675_interface_debug_print);
+        if (max6675_init(&gs_handle[j]) != 0)
+        {
+            max6675_interface_debug_print("sim: max6675 init failed.\n");
+            raspberrypi4b_max6675_sim_set_virtual_clock(0);
+            
+            return 1;
+        }
+        (void)max6675_set_print_mode(&gs_handle[j], MAX6675_PRINT_MODE_NONE);
+    }
+    memset(count, 0, sizeof(count));
+    bad = 0;
+    
+    /* a read inside the conversion window gets the last frame and aborts the conversion */
+    (void)max6675_read(&gs_handle[0], &raw[0], &temp);
+    (void)max6675_read(&gs_handle[0], &raw[1], &temp);
+    if ((raw[0] != raw[1]) || (gs_sim[0].aborted != 2))
+    {
+        bad++;
+    }
+    
+    /* inject the spi failures and the corrupt frames */
+    for (j = 0; j < SIM_BENCHMARK_SENSORS; j++)
+    {
+        gs_sim[j].fail_ppm = 1000;
+        gs_sim[j].corrupt_ppm = 1000;
+    }
+    
+    /* every chip finishes its conversion before the next sample */
+    start = periodic_now_ns();
+    for (i = 0; i < times; i++)
+    {
+        raspberrypi4b_max6675_sim_delay_ms(SIM_BENCHMARK_PERIOD_MS);
+        for (j = 0; j < SIM_BENCHMARK_SENSORS; j++)
+        {
+            uint32_t end;
+            float expect;
+            uint8_t res;
+            
+            end = gs_sim[j].conv_tick + RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS;
+            res = max6675_read(&gs_handle[j], &raw[0], &temp);
+            count[(res < 7) ? res : 0]++;
+            if (res == 0)
+            {
+                expect = fminf(raspberrypi4b_max6675_sim_temperature(&gs_sim[j], end), 1023.75f);
+                if ((gs_sim[j].open != 0) ||
+                    (fabsf(temp - expect) > 6.0f * SIM_BENCHMARK_NOISE + 0.25f))
+                {
+                    bad++;
+                }
+            }
+            else if ((res == 4) && (gs_sim[j].open == 0))
+            {
+                bad++;
+            }
+            else
+            {
+                /* failures are checked with the simulator counters */
+            }
+        }
+    }
+    s = (double)(periodic_now_ns() - start) / 1000000000.0;
+    
+    /* every injected failure is seen by the driver */
+    fails = 0;
+    corrupts = 0;
+    for (j = 0; j < SIM_BENCHMARK_SENSORS; j++)
+    {
+        fails += gs_sim[j].fails;
+        corrupts += gs_sim[j].corrupts;
+    }
+    if ((fails != count[1]) || (corrupts != count[6]))
+    {
+        bad++;
+    }
+    
+    /* a sub-zero junction is clamped to the 0x0000 frame, it is 0C unless the stuck low check is enabled */
+    gs_sim[0].fail_ppm = 0;
+    gs_sim[0].corrupt_ppm = 0;
+    gs_sim[0].base = -20.0f;
+    gs_sim[0].amplitude = 0.0f;
+    gs_sim[0].noise = 0.0f;
+    raspberrypi4b_max6675_sim_delay_ms(SIM_BENCHMARK_PERIOD_MS);
+    raw[0] = 0xFFFF;
+    if ((max6675_read(&gs_handle[0], &raw[0], &temp) != 0) || (raw[0] != 0))
+    {
+        bad++;
+    }
+    (void)max6675_set_stuck_low(&gs_handle[0], MAX6675_BOOL_TRUE);
+    raspberrypi4b_max6675_sim_delay_ms(SIM_BENCHMARK_PERIOD_MS);
+    if (max6675_read(&gs_handle[0], &raw[0], &temp) != 6)
+    {
+        bad++;
+    }
+    for (j = 0; j < SIM_BENCHMARK_SENSORS; j++)
+    {
+        (void)max6675_deinit(&gs_handle[j]);
+    }
+    raspberrypi4b_max6675_sim_set_virtual_clock(0);
+    max6675_interface_debug_print("sim: %d sensors %0.1f kreads/s.\n", SIM_BENCHMARK_SENSORS,
+                                  (double)times * SIM_BENCHMARK_SENSORS / s / 1000.0);
+    max6675_interface_debug_print("sim: %d ok, %d open, %d spi fail, %d corrupt.\n",
+                                  count[0], count[4], count[1], count[6]);
+    max6675_interface_debug_print("sim: %d bad samples.\n", bad);
+    
+    return (bad != 0) ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_format.h
+ * @brief     raspberrypi4b driver max6675 format header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_FORMAT_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_FORMAT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_format raspberrypi4b max6675 format
+ * @brief    raspberrypi4b max6675 format modules
+ * @{
+ */
+
+/**
+ * @brief format definition
+ */
+#define RASPBERRYPI4B_MAX6675_FORMAT_BUFFER_SIZE        65536        /**< output buffer size */
+#define RASPBERRYPI4B_MAX6675_FORMAT_MAX_LINE           96           /**< longest formatted line */
+
+/**
+ * @brief raspberrypi4b max6675 format type enumeration definition
+ */
+typedef enum
+{
+    RASPBERRYPI4B_MAX6675_FORMAT_CSV  = 0x00,        /**< tick_ms,sensor,temperature_c,status */
+    RASPBERRYPI4B_MAX6675_FORMAT_JSON = 0x01,        /**< one json object per line */
+} raspberrypi4b_max6675_format_type_t;
+
+/**
+ * @brief raspberrypi4b max6675 format structure definition
+ */
+typedef struct raspberrypi4b_max6675_format_s
+{
+    int fd;                                                    /**< output handle */
+    raspberrypi4b_max6675_format_type_t type;                  /**< line format */
+    uint32_t len;                                              /**< buffered bytes */
+    uint64_t lines;                                            /**< formatted lines */
+    uint64_t written;                                          /**< written bytes */
+    char buf[RASPBERRYPI4B_MAX6675_FORMAT_BUFFER_SIZE];        /**< output buffer */
+} raspberrypi4b_max6675_format_t;
+
+/**
+ * @brief     format open an output
+ * @param[in] *format pointer to a format structure
+ * @param[in] fd output handle, the format owns it
+ * @param[in] type line format
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the csv header line is buffered at once
+ */
+uint8_t raspberrypi4b_max6675_format_open_fd(raspberrypi4b_max6675_format_t *format, int fd,
+                                             raspberrypi4b_max6675_format_type_t type);
+
+/**
+ * @brief      format write a decimal number
+ * @param[out] *buf pointer to a text buffer of at least 10 bytes
+ * @param[in]  v number
+ * @return     written length
+ * @note       two digits per step from a table, no division by a variable and no locale
+ */
+uint32_t raspberrypi4b_max6675_format_u32(char *buf, uint32_t v);
+
+/**
+ * @brief      format write a quarter degree temperature
+ * @param[out] *buf pointer to a text buffer of at least 13 bytes
+ * @param[in]  raw raw temperature in 0.25C
+ * @return     written length
+ * @note       the same text as printf %0.2f of raw * 0.25f
+ */
+uint32_t raspberrypi4b_max6675_format_quarter(char *buf, uint32_t raw);
+
+/**
+ * @brief      format a sample line
+ * @param[out] *buf pointer to a text buffer of RASPBERRYPI4B_MAX6675_FORMAT_MAX_LINE bytes
+ * @param[in]  type line format
+ * @param[in]  tick tick in ms
+ * @param[in]  id sensor id
+ * @param[in]  raw raw temperature in 0.25C
+ * @param[in]  status read status code
+ * @return     written length
+ * @note       a csv line is the same text as "%u,%u,%0.2f,%d\n" with 0.00 for a failed read, a json
+ *             line has a null temperature for a failed read
+ */
+uint32_t raspberrypi4b_max6675_format_line(char *buf, raspberrypi4b_max6675_format_type_t type,
+                                           uint32_t tick, uint8_t id, uint16_t raw, uint8_t status);
+
+/**
+ * @brief     format write a sample
+ * @param[in] *format pointer to a format structure
+ * @param[in] tick tick in ms
+ * @param[in] id sensor id
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the line is formatted in place in the buffer, which is written only when it is full
+ */
+uint8_t raspberrypi4b_max6675_format_write(raspberrypi4b_max6675_format_t *format, uint32_t tick,
+                                           uint8_t id, uint16_t raw, uint8_t status);
+
+/**
+ * @brief     format write the buffered lines
+ * @param[in] *format pointer to a format structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_format_flush(raspberrypi4b_max6675_format_t *format);
+
+/**
+ * @brief     format close
+ * @param[in] *format pointer to a format structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the buffered lines are written and the handle is closed
+ */
+uint8_t raspberrypi4b_max6675_format_close(raspberrypi4b_max6675_format_t *format);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_history.h
+ * @brief     raspberrypi4b driver max6675 history header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_HISTORY_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_history raspberrypi4b max6675 history
+ * @brief    raspberrypi4b max6675 history modules
+ * @{
+ */
+
+/**
+ * @brief history file definition
+ * @note  a history is a 16 bytes header of the magic, the version and a reserved word and then
+ *        the chunks, every chunk is a 24 bytes header and a payload, the first sample is kept in
+ *        the header and every other sample is two varints, the zigzag delta of raw << 3 | status
+ *        and the zigzag delta of delta of the tick, all words are little endian
+ */
+#define RASPBERRYPI4B_MAX6675_HISTORY_MAGIC                "MAX6675H"        /**< file magic */
+#define RASPBERRYPI4B_MAX6675_HISTORY_VERSION              1                 /**< file version */
+#define RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE          16                /**< file header size */
+#define RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE    24                /**< chunk header size */
+#define RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES        4096              /**< max samples in one chunk */
+#define RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_PAYLOAD_SIZE   (RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES * 8)        /**< max payload size */
+
+/**
+ * @brief raspberrypi4b max6675 history chunk structure definition
+ */
+typedef struct raspberrypi4b_max6675_history_chunk_s
+{
+    uint32_t size;              /**< payload size */
+    uint32_t count;             /**< sample number */
+    uint32_t first_tick;        /**< tick of the first sample */
+    uint32_t last_tick;         /**< tick of the last sample */
+    uint16_t min;               /**< min raw of the good samples, 0xFFFF without one */
+    uint16_t max;               /**< max raw of the good samples, 0 without one */
+    uint16_t first;             /**< raw << 3 | status of the first sample */
+    uint16_t faults;            /**< samples with a status */
+} raspberrypi4b_max6675_history_chunk_t;
+
+/**
+ * @brief raspberrypi4b max6675 history writer structure definition
+ */
+typedef struct raspberrypi4b_max6675_history_writer_s
+{
+    int fd;                                                               /**< history file handle */
+    raspberrypi4b_max6675_history_chunk_t chunk;                          /**< open chunk */
+    uint32_t prev_tick;                                                   /**< tick of the last sample */
+    int32_t prev_delta;                                                   /**< last tick delta */
+    uint16_t prev_value;                                                  /**< raw << 3 | status of the last sample */
+    uint64_t samples;                                                     /**< written samples */
+    uint64_t bytes;                                                       /**< written bytes */
+    uint8_t buf[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_PAYLOAD_SIZE];        /**< chunk payload */
+} raspberrypi4b_max6675_history_writer_t;
+
+/**
+ * @brief raspberrypi4b max6675 history reader structure definition
+ */
+typedef struct raspberrypi4b_max6675_history_reader_s
+{
+    int fd;                     /**< history file handle */
+    const uint8_t *map;         /**< mapped history file */
+    size_t size;                /**< mapped size */
+    size_t off;                 /**< next chunk offset */
+} raspberrypi4b_max6675_history_reader_t;
+
+/**
+ * @brief     history writer open
+ * @param[in] *w pointer to a history writer structure
+ * @param[in] *path pointer to a history file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a new file is created and an existing history is appended to after a torn last
+ *            chunk is cut
+ */
+uint8_t raspberrypi4b_max6675_history_open(raspberrypi4b_max6675_history_writer_t *w, const char *path);
+
+/**
+ * @brief     history writer add a sample
+ * @param[in] *w pointer to a history writer structure
+ * @param[in] tick tick in ms
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a full chunk is written to the file, the samples are only kept in memory before
+ */
+uint8_t raspberrypi4b_max6675_history_write(raspberrypi4b_max6675_history_writer_t *w, uint32_t tick,
+                                            uint16_t raw, uint8_t status);
+
+/**
+ * @brief     history writer write the open chunk
+ * @param[in] *w pointer to a history writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      every flush ends a chunk, so flush seldom
+ */
+uint8_t raspberrypi4b_max6675_history_flush(raspberrypi4b_max6675_history_writer_t *w);
+
+/**
+ * @brief     history writer close
+ * @param[in] *w pointer to a history writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the open chunk is written first
+ */
+uint8_t raspberrypi4b_max6675_history_close(raspberrypi4b_max6675_history_writer_t *w);
+
+/**
+ * @brief     history reader open
+ * @param[in] *r pointer to a history reader structure
+ * @param[in] *path pointer to a history file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the history is memory mapped and read in place
+ */
+uint8_t raspberrypi4b_max6675_history_reader_open(raspberrypi4b_max6675_history_reader_t *r, const char *path);
+
+/**
+ * @brief      history reader get the next chunk
+ * @param[in]  *r pointer to a history reader structure
+ * @param[out] *chunk pointer to a chunk header buffer
+ * @param[out] **payload pointer to a payload pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no more chunks
+ * @note       only the header is read, so the chunks out of the wanted time or temperature range
+ *             are skipped without touching their payload, a torn chunk at the end is ignored
+ */
+uint8_t raspberrypi4b_max6675_history_reader_next(raspberrypi4b_max6675_history_reader_t *r,
+                                                  raspberrypi4b_max6675_history_chunk_t *chunk,
+                                                  const uint8_t **payload);
+
+/**
+ * @brief     history reader rewind to the first chunk
+ * @param[in] *r pointer to a history reader structure
+ * @note      none
+ */
+void raspberrypi4b_max6675_history_reader_rewind(raspberrypi4b_max6675_history_reader_t *r);
+
+/**
+ * @brief     history reader close
+ * @param[in] *r pointer to a history reader structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_history_reader_close(raspberrypi4b_max6675_history_reader_t *r);
+
+/**
+ * @brief      history decode a chunk
+ * @param[in]  *chunk pointer to a chunk header
+ * @param[in]  *payload pointer to the chunk payload
+ * @param[out] *tick pointer to a tick buffer with chunk->count entries
+ * @param[out] *raw pointer to a raw buffer with chunk->count entries
+ * @param[out] *status pointer to a status buffer with chunk->count entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 chunk is malformed
+ * @note       none
+ */
+uint8_t raspberrypi4b_max6675_history_decode(const raspberrypi4b_max6675_history_chunk_t *chunk, const uint8_t *payload,
+                                             uint32_t *tick, uint16_t *raw, uint8_t *status);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
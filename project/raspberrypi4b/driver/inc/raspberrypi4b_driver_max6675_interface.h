@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_interface.h
+ * @brief     raspberrypi4b driver max6675 interface header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_INTERFACE_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_INTERFACE_H
+
+#include "driver_max6675_interface.h"
+#include "spi.h"
+#include "periodic.h"
+#include "spi_fanout.h"
+#include "raspberrypi4b_driver_max6675_sim.h"
+#include "raspberrypi4b_driver_max6675_trace.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_interface raspberrypi4b max6675 interface
+ * @brief    raspberrypi4b max6675 interface modules
+ * @{
+ */
+
+/**
+ * @brief raspberrypi4b max6675 device structure definition
+ * @note  pass a device as the handle context of the spidev link functions, every device owns its
+ *        spidev handle
+ */
+typedef struct raspberrypi4b_max6675_device_s
+{
+    char *name;                 /**< spi device name */
+    uint32_t freq;              /**< spi running frequence */
+    int fd;                     /**< spi handle */
+    spi_prepared_t read;        /**< prepared frame read */
+} raspberrypi4b_max6675_device_t;
+
+/**
+ * @brief raspberrypi4b max6675 fanout device structure definition
+ * @note  pass a fanout device as the handle context of the fanout link functions
+ */
+typedef struct raspberrypi4b_max6675_fanout_device_s
+{
+    spi_fanout_t *fanout;        /**< gpio cs fanout */
+    uint16_t line;               /**< cs line in the fanout */
+} raspberrypi4b_max6675_fanout_device_t;
+
+/**
+ * @brief     initialize raspberrypi4b_max6675_device_t structure
+ * @param[in] DEVICE pointer to a raspberrypi4b max6675 device structure
+ * @param[in] NAME spi device name
+ * @note      none
+ */
+#define RASPBERRYPI4B_MAX6675_DEVICE_INIT(DEVICE, NAME)      \
+    do                                                      \
+    {                                                       \
+        memset((DEVICE), 0, sizeof(*(DEVICE)));             \
+        (DEVICE)->name = (NAME);                            \
+        (DEVICE)->freq = 1000 * 1000;                       \
+        (DEVICE)->fd = -1;                                  \
+    } while (0)
+
+/**
+ * @brief     initialize raspberrypi4b_max6675_fanout_device_t structure
+ * @param[in] DEVICE pointer to a raspberrypi4b max6675 fanout device structure
+ * @param[in] FANOUT pointer to an inited spi fanout structure
+ * @param[in] LINE cs line
+ * @note      the fanout owns the bus, so the spi init and deinit of the device do nothing
+ */
+#define RASPBERRYPI4B_MAX6675_FANOUT_DEVICE_INIT(DEVICE, FANOUT, LINE)        \
+    do                                                                        \
+    {                                                                         \
+        (DEVICE)->fanout = (FANOUT);                                          \
+        (DEVICE)->line = (LINE);                                              \
+    } while (0)
+
+/**
+ * @brief     spidev spi bus init
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the spidev is opened and the frame read is prepared once
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_init(void *ctx);
+
+/**
+ * @brief     spidev spi bus deinit
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_deinit(void *ctx);
+
+/**
+ * @brief      spidev spi bus read
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a frame read runs the prepared transaction into buf without any setup
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      spidev spi bus read many
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a spidev device has one cs and one chip and one SPI_IOC_MESSAGE can not span the
+ *             cs lines of other spidev nodes, so it only reads a single frame and fails with
+ *             num > 1 instead of giving the other devices the frame of this chip
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);
+
+/**
+ * @brief     fanout spi bus init
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the fanout owns the bus, so only the device is checked
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_init(void *ctx);
+
+/**
+ * @brief     fanout spi bus deinit
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the fanout owns the bus and stays open
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_deinit(void *ctx);
+
+/**
+ * @brief      fanout spi bus read
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the gpio cs line of the device is selected around the transfer
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      fanout spi bus read many
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       fanout lines 0 to num - 1 are read with batched gpio cs sets
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);
+
+/**
+ * @brief     run the default device on a simulator
+ * @param[in] *sim pointer to an inited simulator structure, NULL goes back to the bus
+ * @note      the delay, tick and wait interface functions follow the simulator clock too,
+ *            so the driver test runs unchanged on the virtual clock
+ */
+void raspberrypi4b_max6675_set_sim(raspberrypi4b_max6675_sim_t *sim);
+
+/**
+ * @brief     run the default device on a trace
+ * @param[in] *replay pointer to an opened replay structure, NULL goes back to the bus
+ * @note      the clock is not changed, the replay paces the frames itself
+ */
+void raspberrypi4b_max6675_set_replay(raspberrypi4b_max6675_replay_t *replay);
+
+/**
+ * @brief     capture every frame read from the default device
+ * @param[in] *capture pointer to an opened capture structure, NULL stops the capture
+ * @note      the capture is linked over the bus of the default device
+ */
+void raspberrypi4b_max6675_set_capture(raspberrypi4b_max6675_capture_t *capture);
+
+/**
+ * @brief      get the wait statistics
+ * @param[out] *stats pointer to a periodic statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the lateness of every max6675_interface_wait_until_ms wake up is recorded
+ */
+uint8_t raspberrypi4b_max6675_get_wait_stats(periodic_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_metrics.h
+ * @brief     raspberrypi4b driver max6675 metrics header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_METRICS_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_METRICS_H
+
+#include "driver_max6675.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_metrics raspberrypi4b max6675 metrics
+ * @brief    raspberrypi4b max6675 metrics modules
+ * @{
+ */
+
+/**
+ * @brief metrics definition
+ */
+#define RASPBERRYPI4B_MAX6675_METRICS_PORT            9675         /**< default http port */
+#define RASPBERRYPI4B_MAX6675_METRICS_MAX_SENSORS     16           /**< max sensors */
+#define RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS     8            /**< max concurrent scrapes */
+#define RASPBERRYPI4B_MAX6675_METRICS_BUCKETS         11           /**< latency buckets with +Inf */
+#define RASPBERRYPI4B_MAX6675_METRICS_REQUEST_SIZE    1024         /**< longest request head */
+#define RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE   32768        /**< longest response */
+
+/**
+ * @brief raspberrypi4b max6675 metrics sensor structure definition
+ */
+typedef struct raspberrypi4b_max6675_metrics_sensor_s
+{
+    uint8_t valid;                                                /**< 1 after the first good read */
+    uint8_t status;                                               /**< latest read status code */
+    uint16_t raw;                                                 /**< latest good raw temperature in 0.25C */
+    uint64_t reads;                                               /**< reads */
+    max6675_stats_t stats;                                        /**< driver statistics */
+    uint64_t bucket[RASPBERRYPI4B_MAX6675_METRICS_BUCKETS];       /**< read latency histogram, not cumulative */
+    uint64_t sum_ns;                                              /**< read latency sum */
+} raspberrypi4b_max6675_metrics_sensor_t;
+
+/**
+ * @brief raspberrypi4b max6675 metrics client structure definition
+ */
+typedef struct raspberrypi4b_max6675_metrics_client_s
+{
+    int fd;                                                          /**< socket, -1 is a free slot */
+    uint32_t len;                                                    /**< received request bytes */
+    uint32_t sent;                                                   /**< sent response bytes */
+    uint32_t size;                                                   /**< response size, 0 before the request is complete */
+    char request[RASPBERRYPI4B_MAX6675_METRICS_REQUEST_SIZE];        /**< request head */
+    char response[RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE];      /**< response snapshot */
+} raspberrypi4b_max6675_metrics_client_t;
+
+/**
+ * @brief raspberrypi4b max6675 metrics structure definition
+ */
+typedef struct raspberrypi4b_max6675_metrics_s
+{
+    int fd;                                                                              /**< listening socket */
+    int epfd;                                                                            /**< epoll handle */
+    uint16_t port;                                                                       /**< bound port */
+    uint32_t num;                                                                        /**< sensor number */
+    uint32_t scrapes;                                                                    /**< served scrapes */
+    uint32_t renders;                                                                    /**< rendered responses */
+    uint32_t len;                                                                        /**< response length */
+    uint8_t dirty;                                                                       /**< 1 if a sample came after the last render */
+    raspberrypi4b_max6675_metrics_sensor_t sensor[RASPBERRYPI4B_MAX6675_METRICS_MAX_SENSORS];   /**< sensors */
+    raspberrypi4b_max6675_metrics_client_t client[RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS];   /**< scrapes */
+    char body[RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE];                              /**< rendered body */
+    char response[RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE];                          /**< rendered response */
+} raspberrypi4b_max6675_metrics_t;
+
+/**
+ * @brief     metrics open the http listener
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] *address pointer to an ipv4 address to bind, NULL binds every interface
+ * @param[in] port tcp port, 0 picks a free one
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the bound port is kept in metrics->port
+ */
+uint8_t raspberrypi4b_max6675_metrics_open(raspberrypi4b_max6675_metrics_t *metrics, const char *address,
+                                           uint16_t port, uint32_t num);
+
+/**
+ * @brief     metrics update a sensor
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] index sensor index
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status max6675_read status code
+ * @param[in] latency_ns read time
+ * @param[in] *stats pointer to the driver statistics of the sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ * @note      the sensor is only marked dirty here, the next scrape renders the response once
+ */
+uint8_t raspberrypi4b_max6675_metrics_update(raspberrypi4b_max6675_metrics_t *metrics, uint32_t index, uint16_t raw,
+                                             uint8_t status, uint64_t latency_ns, const max6675_stats_t *stats);
+
+/**
+ * @brief     metrics serve the scrapes
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] timeout_ms longest wait for an event, 0 does not wait
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      GET /metrics gets a response of the latest samples, every other request gets 404, the
+ *            connection is closed after the response, nothing is allocated and the bus is not used
+ */
+uint8_t raspberrypi4b_max6675_metrics_poll(raspberrypi4b_max6675_metrics_t *metrics, int timeout_ms);
+
+/**
+ * @brief     metrics close
+ * @param[in] *metrics pointer to a metrics structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_metrics_close(raspberrypi4b_max6675_metrics_t *metrics);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_sampler.h
+ * @brief     raspberrypi4b driver max6675 sampler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_SAMPLER_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_SAMPLER_H
+
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_sampler raspberrypi4b max6675 sampler
+ * @brief    raspberrypi4b max6675 sampler modules
+ * @{
+ */
+
+/**
+ * @brief sampler limit definition
+ */
+#define RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS           8         /**< max spi controllers */
+#define RASPBERRYPI4B_MAX6675_SAMPLER_MAX_DEVICE        32        /**< max devices on one controller */
+
+/**
+ * @brief sampler cache line definition
+ */
+#define RASPBERRYPI4B_MAX6675_SAMPLER_CACHE_LINE        64        /**< keeps the threads off each other's lines */
+
+/**
+ * @brief raspberrypi4b max6675 sample structure definition
+ */
+typedef struct raspberrypi4b_max6675_sample_s
+{
+    uint64_t timestamp_ns;        /**< monotonic time of the read */
+    uint16_t index;               /**< handle index */
+    uint16_t raw;                 /**< raw data */
+    float temp;                   /**< converted temperature */
+    uint8_t status;               /**< max6675_read status code */
+    uint8_t bus;                  /**< spi controller */
+} raspberrypi4b_max6675_sample_t;
+
+/**
+ * @brief raspberrypi4b max6675 sampler queue cell structure definition
+ */
+typedef struct raspberrypi4b_max6675_sampler_cell_s
+{
+    uint32_t seq;                                 /**< cell sequence */
+    raspberrypi4b_max6675_sample_t sample;        /**< sample */
+} raspberrypi4b_max6675_sampler_cell_t;
+
+/**
+ * @brief raspberrypi4b max6675 sampler bus structure definition
+ */
+typedef struct raspberrypi4b_max6675_sampler_bus_s
+{
+    struct raspberrypi4b_max6675_sampler_s *sampler;                               /**< owner */
+    pthread_t thread;                                                              /**< io thread */
+    uint8_t bus;                                                                   /**< spi controller */
+    uint8_t started;                                                               /**< thread is started */
+    int cpu;                                                                       /**< pinned cpu, -1 is not pinned */
+    uint16_t index[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_DEVICE];                      /**< handle indexes */
+    uint16_t num;                                                                  /**< handle number */
+    uint64_t samples;                                                              /**< samples read */
+    periodic_t periodic;                                                           /**< round deadlines */
+} __attribute__((aligned(RASPBERRYPI4B_MAX6675_SAMPLER_CACHE_LINE))) raspberrypi4b_max6675_sampler_bus_t;
+
+/**
+ * @brief raspberrypi4b max6675 sampler structure definition
+ */
+typedef struct raspberrypi4b_max6675_sampler_s
+{
+    raspberrypi4b_max6675_sampler_bus_t bus[RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS];        /**< io threads */
+    uint8_t bus_num;                                                                       /**< io thread number */
+    max6675_handle_t **handle;                                                             /**< handles */
+    uint16_t num;                                                                          /**< handle number */
+    raspberrypi4b_max6675_sampler_cell_t *cell;                                            /**< queue cells */
+    uint32_t mask;                                                                         /**< queue size - 1 */
+    uint32_t period_ms;                                                                    /**< round period, 0 runs freely */
+    volatile uint8_t running;                                                              /**< running flag */
+    uint32_t head __attribute__((aligned(RASPBERRYPI4B_MAX6675_SAMPLER_CACHE_LINE)));      /**< enqueue position */
+    uint32_t tail __attribute__((aligned(RASPBERRYPI4B_MAX6675_SAMPLER_CACHE_LINE)));      /**< dequeue position */
+    uint32_t dropped __attribute__((aligned(RASPBERRYPI4B_MAX6675_SAMPLER_CACHE_LINE)));   /**< samples dropped on a full queue */
+} raspberrypi4b_max6675_sampler_t;
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] **handle pointer to an inited handle list
+ * @param[in] num handle number
+ * @param[in] *cell pointer to a queue cell buffer
+ * @param[in] size queue cell number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 sampler, handle or cell is NULL
+ *            - 4 size is not a power of 2
+ * @note      the ctx of every handle must be a raspberrypi4b_max6675_device_t, the controller is
+ *            parsed from its /dev/spidevB.C name and every controller gets one io thread
+ */
+uint8_t raspberrypi4b_max6675_sampler_init(raspberrypi4b_max6675_sampler_t *sampler,
+                                           max6675_handle_t **handle, uint16_t num,
+                                           raspberrypi4b_max6675_sampler_cell_t *cell, uint32_t size);
+
+/**
+ * @brief     sampler start
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] period_ms round period, 0 reads as fast as the bus allows
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 sampler is NULL
+ * @note      io thread i is pinned to cpu i modulo the online cpus, a failed pinning is not an error,
+ *            the rounds start on absolute deadlines so the read time does not stretch the period
+ */
+uint8_t raspberrypi4b_max6675_sampler_start(raspberrypi4b_max6675_sampler_t *sampler, uint32_t period_ms);
+
+/**
+ * @brief     sampler stop
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ * @note      the io threads finish their round and are joined, queued samples are kept
+ */
+uint8_t raspberrypi4b_max6675_sampler_stop(raspberrypi4b_max6675_sampler_t *sampler);
+
+/**
+ * @brief      sampler pop a sample
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 queue is empty
+ *             - 2 sampler or sample is NULL
+ * @note       lock free and safe with the io threads running
+ */
+uint8_t raspberrypi4b_max6675_sampler_pop(raspberrypi4b_max6675_sampler_t *sampler, raspberrypi4b_max6675_sample_t *sample);
+
+/**
+ * @brief      sampler get the round period statistics of a controller
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index io thread index
+ * @param[out] *stats pointer to a periodic statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ *             - 2 sampler or stats is NULL
+ * @note       only a sampler started with a period records the statistics
+ */
+uint8_t raspberrypi4b_max6675_sampler_get_period_stats(raspberrypi4b_max6675_sampler_t *sampler, uint8_t index, periodic_stats_t *stats);
+
+/**
+ * @brief      sampler get the dropped sample number
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sampler or dropped is NULL
+ * @note       an io thread drops the sample instead of waiting when the queue is full
+ */
+uint8_t raspberrypi4b_max6675_sampler_get_dropped(raspberrypi4b_max6675_sampler_t *sampler, uint32_t *dropped);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
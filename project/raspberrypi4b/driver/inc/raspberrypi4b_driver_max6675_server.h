@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_server.h
+ * @brief     raspberrypi4b driver max6675 server header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_SERVER_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_SERVER_H
+
+#include "raspberrypi4b_driver_max6675_trace.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_server raspberrypi4b max6675 server
+ * @brief    raspberrypi4b max6675 server modules
+ * @{
+ */
+
+/**
+ * @brief server definition
+ * @note  a subscriber gets the trace header and then one trace record per sample, it may send a
+ *        line with a decimation n at any time to get only every n-th sample of every sensor
+ */
+#define RASPBERRYPI4B_MAX6675_SERVER_SOCKET           "/tmp/max6675.sock"        /**< default socket path */
+#define RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS      64                         /**< max subscribers */
+#define RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE       32768                      /**< queued bytes per subscriber, a power of 2 */
+#define RASPBERRYPI4B_MAX6675_SERVER_DROP_LIMIT       4096                       /**< records dropped in a row before a subscriber is disconnected */
+#define RASPBERRYPI4B_MAX6675_SERVER_MAX_DECIMATION   65535                      /**< max decimation */
+
+/**
+ * @brief raspberrypi4b max6675 server client structure definition
+ */
+typedef struct raspberrypi4b_max6675_server_client_s
+{
+    int fd;                                                     /**< socket, -1 is a free slot */
+    uint8_t armed;                                              /**< 1 while waiting for EPOLLOUT */
+    uint8_t line_len;                                           /**< received bytes of the request line */
+    char line[14];                                              /**< request line */
+    uint32_t decimation;                                        /**< send every n-th sample */
+    uint32_t head;                                              /**< queue write position */
+    uint32_t tail;                                              /**< queue send position */
+    uint32_t dropped;                                           /**< records dropped on a full queue */
+    uint32_t run;                                               /**< records dropped since the last progress */
+    uint8_t queue[RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE];     /**< send queue */
+} raspberrypi4b_max6675_server_client_t;
+
+/**
+ * @brief raspberrypi4b max6675 server structure definition
+ */
+typedef struct raspberrypi4b_max6675_server_s
+{
+    int fd;                                                                           /**< listening socket */
+    int epfd;                                                                         /**< epoll handle */
+    char path[108];                                                                   /**< socket path */
+    uint32_t clients;                                                                 /**< connected subscribers */
+    uint32_t accepted;                                                                /**< accepted subscribers */
+    uint32_t disconnected;                                                            /**< slow subscribers disconnected */
+    uint64_t dropped;                                                                 /**< records dropped for slow subscribers */
+    uint64_t sent;                                                                    /**< bytes sent */
+    uint32_t writes;                                                                  /**< gathered writes */
+    uint32_t count[256];                                                              /**< published samples of every sensor id */
+    int watch_fd;                                                                     /**< watched handle, -1 is none */
+    void (*watch)(void *arg);                                                         /**< called when the watched handle is readable */
+    void *watch_arg;                                                                  /**< watch argument */
+    raspberrypi4b_max6675_server_client_t client[RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS];   /**< subscribers */
+} raspberrypi4b_max6675_server_t;
+
+/**
+ * @brief     server open a socket for the subscribers
+ * @param[in] *server pointer to a server structure
+ * @param[in] *path pointer to a unix socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a stale socket file of the same path is removed
+ */
+uint8_t raspberrypi4b_max6675_server_open(raspberrypi4b_max6675_server_t *server, const char *path);
+
+/**
+ * @brief      server handle the socket events
+ * @param[in]  *server pointer to a server structure
+ * @param[in]  timeout_ms longest wait for an event, 0 does not wait
+ * @param[out] *events pointer to a handled event number buffer, 0 means the wait timed out
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ * @note       accepts the subscribers, reads their decimation requests, sends the queued records
+ *             of the subscribers that were not writable and closes the ones that hung up
+ */
+uint8_t raspberrypi4b_max6675_server_poll(raspberrypi4b_max6675_server_t *server, int timeout_ms, uint32_t *events);
+
+/**
+ * @brief     server watch another handle in the same event loop
+ * @param[in] *server pointer to a server structure
+ * @param[in] fd handle to watch, such as another epoll handle
+ * @param[in] *watch pointer to a function called by the poll when the handle is readable
+ * @param[in] *arg pointer to the watch argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 watch failed
+ * @note      only one handle can be watched
+ */
+uint8_t raspberrypi4b_max6675_server_watch(raspberrypi4b_max6675_server_t *server, int fd,
+                                           void (*watch)(void *arg), void *arg);
+
+/**
+ * @brief     server publish a sample
+ * @param[in] *server pointer to a server structure
+ * @param[in] tick tick in ms
+ * @param[in] frame chip register frame
+ * @param[in] id sensor id
+ * @param[in] res read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      the record is only queued, a subscriber with a full queue loses it and is closed after
+ *            RASPBERRYPI4B_MAX6675_SERVER_DROP_LIMIT lost records in a row, so it never blocks the
+ *            sampling
+ */
+uint8_t raspberrypi4b_max6675_server_publish(raspberrypi4b_max6675_server_t *server, uint32_t tick,
+                                             uint16_t frame, uint8_t id, uint8_t res);
+
+/**
+ * @brief     server send the queued records
+ * @param[in] *server pointer to a server structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      every subscriber gets its whole queue in one gathered write without waiting, the rest
+ *            is sent by the poll when the socket is writable again
+ */
+uint8_t raspberrypi4b_max6675_server_flush(raspberrypi4b_max6675_server_t *server);
+
+/**
+ * @brief     server close
+ * @param[in] *server pointer to a server structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the subscribers are disconnected and the socket file is removed
+ */
+uint8_t raspberrypi4b_max6675_server_close(raspberrypi4b_max6675_server_t *server);
+
+/**
+ * @brief      server subscribe as a client
+ * @param[in]  *path pointer to a unix socket path
+ * @param[in]  decimation send every n-th sample
+ * @param[out] *fd pointer to a socket handle buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 subscribe failed
+ * @note       the records are read from the blocking socket after the trace header
+ */
+uint8_t raspberrypi4b_max6675_server_subscribe(const char *path, uint32_t decimation, int *fd);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_shm.h
+ * @brief     raspberrypi4b driver max6675 shared memory header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_SHM_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_SHM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_shm raspberrypi4b max6675 shared memory
+ * @brief    raspberrypi4b max6675 shared memory modules
+ * @{
+ */
+
+/**
+ * @brief shared memory definition
+ */
+#define RASPBERRYPI4B_MAX6675_SHM_NAME           "/max6675"        /**< default segment name */
+#define RASPBERRYPI4B_MAX6675_SHM_MAGIC          0x36363735U       /**< segment magic */
+#define RASPBERRYPI4B_MAX6675_SHM_VERSION        2                 /**< segment version */
+#define RASPBERRYPI4B_MAX6675_SHM_MAX_SENSORS    256               /**< max sensors in one segment */
+#define RASPBERRYPI4B_MAX6675_SHM_COPIES         3                 /**< sample copies of one slot */
+#define RASPBERRYPI4B_MAX6675_SHM_RETRY          64                /**< reader attempts before it gives up */
+
+/**
+ * @brief raspberrypi4b max6675 shared memory sample structure definition
+ */
+typedef struct raspberrypi4b_max6675_shm_sample_s
+{
+    uint32_t count;             /**< published samples, 0 before the first one */
+    uint32_t tick;              /**< publisher tick in ms */
+    uint16_t raw;               /**< raw temperature in 0.25C */
+    uint8_t status;             /**< read status code */
+    uint8_t reserved;           /**< reserved */
+    int32_t temp;               /**< temperature in 0.01C */
+} raspberrypi4b_max6675_shm_sample_t;
+
+/**
+ * @brief raspberrypi4b max6675 shared memory slot structure definition
+ * @note  every slot owns a cache line, so a sensor update never disturbs the readers of another,
+ *        sample gen is in copy gen % RASPBERRYPI4B_MAX6675_SHM_COPIES and the publisher only
+ *        writes the copy after the newest one
+ */
+typedef struct raspberrypi4b_max6675_shm_slot_s
+{
+    uint32_t gen;                                                               /**< generation of the newest copy */
+    raspberrypi4b_max6675_shm_sample_t copy[RASPBERRYPI4B_MAX6675_SHM_COPIES];  /**< sample copies */
+} __attribute__((aligned(64))) raspberrypi4b_max6675_shm_slot_t;
+
+/**
+ * @brief raspberrypi4b max6675 shared memory segment structure definition
+ */
+typedef struct raspberrypi4b_max6675_shm_segment_s
+{
+    uint32_t magic;                                                       /**< segment magic */
+    uint32_t version;                                                     /**< segment version */
+    uint32_t num;                                                         /**< sensor number */
+    int32_t pid;                                                          /**< publisher pid */
+    raspberrypi4b_max6675_shm_slot_t slot[RASPBERRYPI4B_MAX6675_SHM_MAX_SENSORS] __attribute__((aligned(64)));        /**< sensor slots */
+} raspberrypi4b_max6675_shm_segment_t;
+
+/**
+ * @brief raspberrypi4b max6675 shared memory structure definition
+ */
+typedef struct raspberrypi4b_max6675_shm_s
+{
+    int fd;                                        /**< shared memory handle */
+    raspberrypi4b_max6675_shm_segment_t *seg;      /**< mapped segment */
+    uint8_t publisher;                             /**< 1 if the segment is owned */
+    char name[64];                                 /**< segment name */
+} raspberrypi4b_max6675_shm_t;
+
+/**
+ * @brief     shared memory create a segment to publish to
+ * @param[in] *shm pointer to a shared memory structure
+ * @param[in] *name pointer to a segment name starting with a slash
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      an old segment of the same name is reused, so the readers stay attached while the
+ *            publisher restarts
+ */
+uint8_t raspberrypi4b_max6675_shm_create(raspberrypi4b_max6675_shm_t *shm, const char *name, uint32_t num);
+
+/**
+ * @brief     shared memory publish a sample
+ * @param[in] *shm pointer to a shared memory structure
+ * @param[in] index sensor index
+ * @param[in] tick tick in ms
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      only one thread may publish to a segment, it never waits for the readers
+ */
+uint8_t raspberrypi4b_max6675_shm_publish(raspberrypi4b_max6675_shm_t *shm, uint32_t index, uint32_t tick,
+                                          uint16_t raw, uint8_t status);
+
+/**
+ * @brief     shared memory open a published segment
+ * @param[in] *shm pointer to a shared memory structure
+ * @param[in] *name pointer to a segment name starting with a slash
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the segment is mapped read only
+ */
+uint8_t raspberrypi4b_max6675_shm_open(raspberrypi4b_max6675_shm_t *shm, const char *name);
+
+/**
+ * @brief      shared memory read the latest sample
+ * @param[in]  *shm pointer to a shared memory structure
+ * @param[in]  index sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 no consistent snapshot in RASPBERRYPI4B_MAX6675_SHM_RETRY attempts
+ * @note       no system call and no lock, the newest copy is never written by the publisher, so
+ *             a snapshot is only read again when the publisher overtakes the reader by
+ *             RASPBERRYPI4B_MAX6675_SHM_COPIES - 1 samples of the sensor during the copy and 4 is
+ *             only returned to a reader that is stalled again and again
+ */
+uint8_t raspberrypi4b_max6675_shm_read(const raspberrypi4b_max6675_shm_t *shm, uint32_t index,
+                                       raspberrypi4b_max6675_shm_sample_t *sample);
+
+/**
+ * @brief     shared memory close
+ * @param[in] *shm pointer to a shared memory structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the segment is kept for the readers, shm_unlink removes it
+ */
+uint8_t raspberrypi4b_max6675_shm_close(raspberrypi4b_max6675_shm_t *shm);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
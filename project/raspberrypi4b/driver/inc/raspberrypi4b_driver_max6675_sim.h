@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_sim.h
+ * @brief     raspberrypi4b driver max6675 simulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_SIM_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_SIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_sim raspberrypi4b max6675 simulator
+ * @brief    raspberrypi4b max6675 simulator modules
+ * @{
+ */
+
+/**
+ * @brief simulator conversion time definition
+ */
+#define RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS        220        /**< max conversion time of the chip */
+
+/**
+ * @brief raspberrypi4b max6675 simulator wave enumeration definition
+ */
+typedef enum
+{
+    RASPBERRYPI4B_MAX6675_SIM_WAVE_CONSTANT = 0x00,        /**< base */
+    RASPBERRYPI4B_MAX6675_SIM_WAVE_RAMP     = 0x01,        /**< base rising by amplitude every period */
+    RASPBERRYPI4B_MAX6675_SIM_WAVE_SINE     = 0x02,        /**< base plus a sine of amplitude */
+    RASPBERRYPI4B_MAX6675_SIM_WAVE_STEP     = 0x03,        /**< base and base plus amplitude every half period */
+} raspberrypi4b_max6675_sim_wave_t;
+
+/**
+ * @brief raspberrypi4b max6675 simulator structure definition
+ */
+typedef struct raspberrypi4b_max6675_sim_s
+{
+    raspberrypi4b_max6675_sim_wave_t wave;        /**< temperature waveform */
+    float base;                                   /**< base temperature in C */
+    float amplitude;                              /**< waveform amplitude in C */
+    uint32_t period_ms;                           /**< waveform period */
+    float noise;                                  /**< gaussian noise standard deviation in C */
+    uint8_t open;                                 /**< 1 opens the thermocouple input */
+    uint32_t fail_ppm;                            /**< spi failures per million reads */
+    uint32_t corrupt_ppm;                         /**< all ones frames per million reads */
+    uint32_t seed;                                /**< random state */
+    uint32_t power_tick;                          /**< power on tick */
+    uint32_t conv_tick;                           /**< start of the running conversion */
+    uint16_t frame;                               /**< output register */
+    uint32_t reads;                               /**< cs assertions */
+    uint32_t aborted;                             /**< reads that aborted a running conversion */
+    uint32_t fails;                               /**< injected spi failures */
+    uint32_t corrupts;                            /**< injected corrupt frames */
+} raspberrypi4b_max6675_sim_t;
+
+/**
+ * @brief     simulator init
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] seed random seed, the same seed gives the same noise and failures
+ * @return    status code
+ *            - 0 success
+ *            - 1 sim is NULL
+ * @note      the chip is powered on now at a constant 25C without noise or failures, the
+ *            output register reads 0 until the first conversion has finished
+ */
+uint8_t raspberrypi4b_max6675_sim_init(raspberrypi4b_max6675_sim_t *sim, uint32_t seed);
+
+/**
+ * @brief     simulator get the temperature of the waveform
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] tick tick in ms
+ * @return    temperature in C without noise
+ * @note      none
+ */
+float raspberrypi4b_max6675_sim_temperature(raspberrypi4b_max6675_sim_t *sim, uint32_t tick);
+
+/**
+ * @brief     simulator spi init
+ * @param[in] *ctx pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_init(void *ctx);
+
+/**
+ * @brief     simulator spi deinit
+ * @param[in] *ctx pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_deinit(void *ctx);
+
+/**
+ * @brief      simulator spi read
+ * @param[in]  *ctx pointer to a simulator structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       as on the chip, cs low shows the last finished conversion and aborts the running
+ *             one and cs high starts a new RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS conversion
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      simulator spi read many
+ * @param[in]  *ctx pointer to a simulator list
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       frame i is read from the i-th simulator of the list
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);
+
+/**
+ * @brief     simulator enable or disable the virtual clock
+ * @param[in] enable 1 runs on the virtual clock, 0 runs on the monotonic clock
+ * @note      the virtual clock only moves with the delay and wait functions, so thousands of
+ *            sensors can be simulated faster than real time
+ */
+void raspberrypi4b_max6675_sim_set_virtual_clock(uint8_t enable);
+
+/**
+ * @brief  simulator get tick ms
+ * @return tick in ms
+ * @note   none
+ */
+uint32_t raspberrypi4b_max6675_sim_get_tick_ms(void);
+
+/**
+ * @brief     simulator delay ms
+ * @param[in] ms time
+ * @note      the virtual clock moves forward at once
+ */
+void raspberrypi4b_max6675_sim_delay_ms(uint32_t ms);
+
+/**
+ * @brief     simulator wait until a tick
+ * @param[in] tick absolute tick
+ * @note      the virtual clock moves forward to the tick at once
+ */
+void raspberrypi4b_max6675_sim_wait_until_ms(uint32_t tick);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_trace.h
+ * @brief     raspberrypi4b driver max6675 trace header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MAX6675_TRACE_H
+#define RASPBERRYPI4B_DRIVER_MAX6675_TRACE_H
+
+#include "periodic.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_max6675_trace raspberrypi4b max6675 trace
+ * @brief    raspberrypi4b max6675 trace modules
+ * @{
+ */
+
+/**
+ * @brief trace file definition
+ * @note  a trace is a 16 bytes header of the magic, the version and the record size as little
+ *        endian uint32 and then one 8 bytes record per frame, the tick in ms as little endian
+ *        uint32, the frame as little endian uint16, the sensor id and the spi result
+ */
+#define RASPBERRYPI4B_MAX6675_TRACE_MAGIC              "MAX6675T"        /**< file magic */
+#define RASPBERRYPI4B_MAX6675_TRACE_VERSION            1                 /**< file version */
+#define RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE        16                /**< header size */
+#define RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE        8                 /**< record size */
+#define RASPBERRYPI4B_MAX6675_TRACE_BUFFER_SIZE        65536             /**< capture buffer size */
+
+/**
+ * @brief raspberrypi4b max6675 replay structure definition
+ */
+typedef struct raspberrypi4b_max6675_replay_s
+{
+    int fd;                          /**< trace file handle */
+    const uint8_t *map;              /**< mapped trace file */
+    size_t size;                     /**< mapped size */
+    uint32_t count;                  /**< record number */
+    uint32_t index;                  /**< next record */
+    float speed;                     /**< 1.0 is real time, 0.0 is as fast as possible */
+    uint8_t loop;                    /**< 1 starts again after the last record */
+    uint64_t start_ns;               /**< playback start time */
+    uint32_t start_tick;             /**< tick of the first played record */
+    periodic_t pace;                 /**< playback lateness */
+} raspberrypi4b_max6675_replay_t;
+
+/**
+ * @brief raspberrypi4b max6675 capture structure definition
+ */
+typedef struct raspberrypi4b_max6675_capture_s
+{
+    int fd;                                                                        /**< trace file handle */
+    uint32_t frames;                                                               /**< captured frames */
+    uint32_t len;                                                                  /**< buffered bytes */
+    uint8_t buf[RASPBERRYPI4B_MAX6675_TRACE_BUFFER_SIZE];                          /**< write buffer */
+    uint8_t (*spi_init)(void *ctx);                                                /**< point to a captured spi_init function address */
+    uint8_t (*spi_deinit)(void *ctx);                                              /**< point to a captured spi_deinit function address */
+    uint8_t (*spi_read_cmd)(void *ctx, uint8_t *buf, uint16_t len);                /**< point to a captured spi_read_cmd function address */
+    uint8_t (*spi_read_many_cmd)(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);    /**< point to a captured spi_read_many_cmd function address */
+    uint32_t (*get_tick_ms)(void);                                                 /**< point to a get_tick_ms function address */
+    void *ctx;                                                                     /**< captured context */
+} raspberrypi4b_max6675_capture_t;
+
+/**
+ * @brief     link the captured bus of a capture
+ * @param[in] CAPTURE pointer to a capture structure
+ * @param[in] INIT pointer to a spi_init function address
+ * @param[in] DEINIT pointer to a spi_deinit function address
+ * @param[in] READ pointer to a spi_read_cmd function address
+ * @param[in] READ_MANY pointer to a spi_read_many_cmd function address, NULL fails every group read
+ * @param[in] CTX pointer to the context of the captured bus
+ * @note      the capture link functions run the captured bus and record every frame
+ */
+#define RASPBERRYPI4B_MAX6675_CAPTURE_LINK(CAPTURE, INIT, DEINIT, READ, READ_MANY, CTX)        \
+    do                                                                                        \
+    {                                                                                         \
+        (CAPTURE)->spi_init = (INIT);                                                         \
+        (CAPTURE)->spi_deinit = (DEINIT);                                                     \
+        (CAPTURE)->spi_read_cmd = (READ);                                                     \
+        (CAPTURE)->spi_read_many_cmd = (READ_MANY);                                           \
+        (CAPTURE)->ctx = (CTX);                                                               \
+    } while (0)
+
+/**
+ * @brief     link the get_tick_ms function of a capture
+ * @param[in] CAPTURE pointer to a capture structure
+ * @param[in] FUC pointer to a get_tick_ms function address
+ * @note      every record is stamped with this tick
+ */
+#define RASPBERRYPI4B_MAX6675_CAPTURE_LINK_GET_TICK_MS(CAPTURE, FUC) (CAPTURE)->get_tick_ms = (FUC)
+
+/**
+ * @brief     replay open a trace
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *path pointer to a trace file path
+ * @param[in] speed playback speed, 1.0 is real time, 2.0 is twice as fast and 0.0 is as fast as possible
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the trace is memory mapped and read in place, so the playback never allocates
+ */
+uint8_t raspberrypi4b_max6675_replay_open(raspberrypi4b_max6675_replay_t *replay, const char *path, float speed);
+
+/**
+ * @brief     replay close the trace
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_replay_close(raspberrypi4b_max6675_replay_t *replay);
+
+/**
+ * @brief     replay check the end of the trace
+ * @param[in] *replay pointer to a replay structure
+ * @return    1 if every record has been played, else 0
+ * @note      a looping replay never ends
+ */
+uint8_t raspberrypi4b_max6675_replay_end(raspberrypi4b_max6675_replay_t *replay);
+
+/**
+ * @brief      replay spi read
+ * @param[in]  *ctx pointer to a replay structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       every read plays the next record, it waits until the record is due at the playback
+ *             speed and returns the recorded frame and spi result, the end of the trace fails
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay spi init
+ * @param[in] *ctx pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the trace must be opened before
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_init(void *ctx);
+
+/**
+ * @brief     replay spi deinit
+ * @param[in] *ctx pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the trace stays open
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_deinit(void *ctx);
+
+/**
+ * @brief      replay spi read many
+ * @param[in]  *ctx pointer to a replay structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the next num records are played
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);
+
+/**
+ * @brief     capture open a trace
+ * @param[in] *capture pointer to a capture structure
+ * @param[in] *path pointer to a trace file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the file is created or truncated
+ */
+uint8_t raspberrypi4b_max6675_capture_open(raspberrypi4b_max6675_capture_t *capture, const char *path);
+
+/**
+ * @brief     capture open a trace on a file handle
+ * @param[in] *capture pointer to a capture structure
+ * @param[in] fd opened file, pipe or socket handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the capture owns the handle and closes it
+ */
+uint8_t raspberrypi4b_max6675_capture_open_fd(raspberrypi4b_max6675_capture_t *capture, int fd);
+
+/**
+ * @brief     capture write a record
+ * @param[in] *capture pointer to a capture structure
+ * @param[in] tick tick in ms
+ * @param[in] frame chip register frame
+ * @param[in] id sensor id
+ * @param[in] res spi result
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the records are buffered and written when the buffer is full
+ */
+uint8_t raspberrypi4b_max6675_capture_write(raspberrypi4b_max6675_capture_t *capture, uint32_t tick,
+                                            uint16_t frame, uint8_t id, uint8_t res);
+
+/**
+ * @brief     capture write all buffered bytes
+ * @param[in] *capture pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the records are kept until the buffer is full without it
+ */
+uint8_t raspberrypi4b_max6675_capture_flush(raspberrypi4b_max6675_capture_t *capture);
+
+/**
+ * @brief     capture close the trace
+ * @param[in] *capture pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the buffered records are written first
+ */
+uint8_t raspberrypi4b_max6675_capture_close(raspberrypi4b_max6675_capture_t *capture);
+
+/**
+ * @brief     capture spi init
+ * @param[in] *ctx pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the captured bus is inited
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_init(void *ctx);
+
+/**
+ * @brief     capture spi deinit
+ * @param[in] *ctx pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the captured bus is deinited, the trace stays open
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_deinit(void *ctx);
+
+/**
+ * @brief      capture spi read
+ * @param[in]  *ctx pointer to a capture structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the captured bus is read and a frame is recorded as sensor 0
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      capture spi read many
+ * @param[in]  *ctx pointer to a capture structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the captured bus is read and frame i is recorded as sensor i with one tick
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
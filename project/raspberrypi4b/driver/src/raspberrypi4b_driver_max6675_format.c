@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_format.c
+ * @brief     raspberrypi4b driver max6675 format source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_max6675_format.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief digit pair table definition
+ */
+static const char gs_digits[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";        /**< "00" to "99" */
+
+/**
+ * @brief quarter degree fraction table definition
+ */
+static const char gs_quarter[4][3] = {".00", ".25", ".50", ".75"};        /**< raw % 4 */
+
+/**
+ * @brief csv header definition
+ */
+static const char gs_csv_header[] = "tick_ms,sensor,temperature_c,status\n";        /**< same fields as a json line */
+
+/**
+ * @brief     append a constant string
+ * @param[in] *buf pointer to a text buffer
+ * @param[in] *s pointer to a string literal
+ * @return    written length
+ * @note      the length is known at compile time so the copy is a few stores
+ */
+#define FORMAT_APPEND(buf, s) (memcpy((buf), (s), sizeof(s) - 1), (uint32_t)(sizeof(s) - 1))
+
+/**
+ * @brief      format write a decimal number
+ * @param[out] *buf pointer to a text buffer of at least 10 bytes
+ * @param[in]  v number
+ * @return     written length
+ * @note       two digits per step from a table, no division by a variable and no locale
+ */
+uint32_t raspberrypi4b_max6675_format_u32(char *buf, uint32_t v)
+{
+    char tmp[10];
+    char *p;
+    uint32_t len;
+    
+    /* fill from the end */
+    p = tmp + sizeof(tmp);
+    while (v >= 100)
+    {
+        uint32_t q = v / 100;
+        
+        p -= 2;
+        memcpy(p, &gs_digits[(v - q * 100) * 2], 2);
+        v = q;
+    }
+    if (v >= 10)
+    {
+        p -= 2;
+        memcpy(p, &gs_digits[v * 2], 2);
+    }
+    else
+    {
+        *--p = (char)('0' + v);
+    }
+    len = (uint32_t)(tmp + sizeof(tmp) - p);
+    memcpy(buf, p, len);
+    
+    return len;
+}
+
+/**
+ * @brief      format write a quarter degree temperature
+ * @param[out] *buf pointer to a text buffer of at least 13 bytes
+ * @param[in]  raw raw temperature in 0.25C
+ * @return     written length
+ * @note       the same text as printf %0.2f of raw * 0.25f
+ */
+uint32_t raspberrypi4b_max6675_format_quarter(char *buf, uint32_t raw)
+{
+    uint32_t len;
+    
+    len = raspberrypi4b_max6675_format_u32(buf, raw >> 2);
+    memcpy(buf + len, gs_quarter[raw & 3], 3);
+    
+    return len + 3;
+}
+
+/**
+ * @brief      format a sample line
+ * @param[out] *buf pointer to a text buffer of RASPBERRYPI4B_MAX6675_FORMAT_MAX_LINE bytes
+ * @param[in]  type line format
+ * @param[in]  tick tick in ms
+ * @param[in]  id sensor id
+ * @param[in]  raw raw temperature in 0.25C
+ * @param[in]  status read status code
+ * @return     written length
+ * @note       a csv line is the same text as "%u,%u,%0.2f,%d\n" with 0.00 for a failed read, a json
+ *             line has a null temperature for a failed read
+ */
+uint32_t raspberrypi4b_max6675_format_line(char *buf, raspberrypi4b_max6675_format_type_t type,
+                                           uint32_t tick, uint8_t id, uint16_t raw, uint8_t status)
+{
+    uint32_t len;
+    
+    if (type == RASPBERRYPI4B_MAX6675_FORMAT_CSV)
+    {
+        len = raspberrypi4b_max6675_format_u32(buf, tick);
+        buf[len++] = ',';
+        len += raspberrypi4b_max6675_format_u32(buf + len, id);
+        buf[len++] = ',';
+        len += raspberrypi4b_max6675_format_quarter(buf + len, (status != 0) ? 0 : raw);
+        buf[len++] = ',';
+        len += raspberrypi4b_max6675_format_u32(buf + len, status);
+        buf[len++] = '\n';
+    }
+    else
+    {
+        len = FORMAT_APPEND(buf, "{\"tick_ms\":");
+        len += raspberrypi4b_max6675_format_u32(buf + len, tick);
+        len += FORMAT_APPEND(buf + len, ",\"sensor\":");
+        len += raspberrypi4b_max6675_format_u32(buf + len, id);
+        len += FORMAT_APPEND(buf + len, ",\"temperature_c\":");
+        if (status != 0)
+        {
+            len += FORMAT_APPEND(buf + len, "null");
+        }
+        else
+        {
+            len += raspberrypi4b_max6675_format_quarter(buf + len, raw);
+        }
+        len += FORMAT_APPEND(buf + len, ",\"status\":");
+        len += raspberrypi4b_max6675_format_u32(buf + len, status);
+        len += FORMAT_APPEND(buf + len, "}\n");
+    }
+    
+    return len;
+}
+
+/**
+ * @brief     format open an output
+ * @param[in] *format pointer to a format structure
+ * @param[in] fd output handle, the format owns it
+ * @param[in] type line format
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the csv header line is buffered at once
+ */
+uint8_t raspberrypi4b_max6675_format_open_fd(raspberrypi4b_max6675_format_t *format, int fd,
+                                             raspberrypi4b_max6675_format_type_t type)
+{
+    if ((format == NULL) || (fd < 0))
+    {
+        return 1;
+    }
+    
+    format->fd = fd;
+    format->type = type;
+    format->len = 0;
+    format->lines = 0;
+    format->written = 0;
+    if (type == RASPBERRYPI4B_MAX6675_FORMAT_CSV)
+    {
+        format->len = FORMAT_APPEND(format->buf, gs_csv_header);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     format write a sample
+ * @param[in] *format pointer to a format structure
+ * @param[in] tick tick in ms
+ * @param[in] id sensor id
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the line is formatted in place in the buffer, which is written only when it is full
+ */
+uint8_t raspberrypi4b_max6675_format_write(raspberrypi4b_max6675_format_t *format, uint32_t tick,
+                                           uint8_t id, uint16_t raw, uint8_t status)
+{
+    if ((format == NULL) || (format->fd < 0))
+    {
+        return 1;
+    }
+    if ((format->len + RASPBERRYPI4B_MAX6675_FORMAT_MAX_LINE) > RASPBERRYPI4B_MAX6675_FORMAT_BUFFER_SIZE)
+    {
+        if (raspberrypi4b_max6675_format_flush(format) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    format->len += raspberrypi4b_max6675_format_line(format->buf + format->len, format->type, tick, id, raw, status);
+    format->lines++;
+    
+    return 0;
+}
+
+/**
+ * @brief     format write the buffered lines
+ * @param[in] *format pointer to a format structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_format_flush(raspberrypi4b_max6675_format_t *format)
+{
+    uint32_t off;
+    ssize_t n;
+    
+    if ((format == NULL) || (format->fd < 0))
+    {
+        return 1;
+    }
+    
+    off = 0;
+    while (off < format->len)
+    {
+        n = write(format->fd, format->buf + off, format->len - off);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        off += (uint32_t)n;
+    }
+    format->written += format->len;
+    format->len = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     format close
+ * @param[in] *format pointer to a format structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the buffered lines are written and the handle is closed
+ */
+uint8_t raspberrypi4b_max6675_format_close(raspberrypi4b_max6675_format_t *format)
+{
+    uint8_t res;
+    
+    if ((format == NULL) || (format->fd < 0))
+    {
+        return 1;
+    }
+    
+    res = raspberrypi4b_max6675_format_flush(format);
+    if (close(format->fd) != 0)
+    {
+        res = 1;
+    }
+    format->fd = -1;
+    
+    return res;
+}
@@ -0,0 +1,618 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_history.c
+ * @brief     raspberrypi4b driver max6675 history source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_max6675_history.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * @brief     get a little endian uint16
+ * @param[in] *p pointer to the bytes
+ * @return    value
+ * @note      none
+ */
+static uint16_t a_history_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief     get a little endian uint32
+ * @param[in] *p pointer to the bytes
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_history_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief      put a little endian uint16
+ * @param[out] *p pointer to the bytes
+ * @param[in]  v value
+ * @note       none
+ */
+static void a_history_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+/**
+ * @brief      put a little endian uint32
+ * @param[out] *p pointer to the bytes
+ * @param[in]  v value
+ * @note       none
+ */
+static void a_history_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief      put a zigzag varint
+ * @param[out] *p pointer to the bytes
+ * @param[in]  v signed value
+ * @return     written bytes
+ * @note       small values of both signs take one byte
+ */
+static uint32_t a_history_put_varint(uint8_t *p, int32_t v)
+{
+    uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+    uint32_t n = 0;
+    
+    while (z >= 0x80)
+    {
+        p[n++] = (uint8_t)(z | 0x80);
+        z >>= 7;
+    }
+    p[n++] = (uint8_t)z;
+    
+    return n;
+}
+
+/**
+ * @brief      get a zigzag varint
+ * @param[in]  *p pointer to the bytes
+ * @param[in]  *end pointer to the end of the bytes
+ * @param[out] *v pointer to a signed value buffer
+ * @return     read bytes, 0 if the varint is cut or too long
+ * @note       none
+ */
+static uint32_t a_history_get_varint(const uint8_t *p, const uint8_t *end, int32_t *v)
+{
+    uint32_t z = 0;
+    uint32_t n = 0;
+    uint32_t shift = 0;
+    
+    while ((p + n) < end)
+    {
+        z |= (uint32_t)(p[n] & 0x7F) << shift;
+        if ((p[n++] & 0x80) == 0)
+        {
+            *v = (int32_t)((z >> 1) ^ (0U - (z & 1)));
+            
+            return n;
+        }
+        shift += 7;
+        if (shift > 28)
+        {
+            break;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     history writer start a chunk
+ * @param[in] *w pointer to a history writer structure
+ * @note      none
+ */
+static void a_history_chunk_reset(raspberrypi4b_max6675_history_writer_t *w)
+{
+    memset(&w->chunk, 0, sizeof(raspberrypi4b_max6675_history_chunk_t));
+    w->chunk.min = 0xFFFF;
+}
+
+/**
+ * @brief     history writer find the end of the last complete chunk
+ * @param[in] fd history file handle
+ * @param[in] size file size
+ * @return    end offset
+ * @note      the chunk headers are walked with the checks of the reader
+ */
+static off_t a_history_tail(int fd, off_t size)
+{
+    uint8_t head[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE];
+    off_t off = RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE;
+    uint32_t len;
+    uint32_t count;
+    
+    while ((off + RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE) <= size)
+    {
+        if (pread(fd, head, sizeof(head), off) != (ssize_t)sizeof(head))
+        {
+            break;
+        }
+        len = a_history_get_u32(head + 0);
+        count = a_history_get_u32(head + 4);
+        if ((count == 0) || (count > RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES) ||
+            (len > RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_PAYLOAD_SIZE) ||
+            ((off_t)len > (size - off - RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE)))
+        {
+            break;
+        }
+        off += RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE + len;
+    }
+    
+    return off;
+}
+
+/**
+ * @brief     history writer open
+ * @param[in] *w pointer to a history writer structure
+ * @param[in] *path pointer to a history file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a new file is created and an existing history is appended to after a torn last
+ *            chunk is cut
+ */
+uint8_t raspberrypi4b_max6675_history_open(raspberrypi4b_max6675_history_writer_t *w, const char *path)
+{
+    uint8_t head[RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE];
+    off_t size;
+    off_t tail;
+    
+    if ((w == NULL) || (path == NULL))
+    {
+        return 1;
+    }
+    
+    w->fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (w->fd < 0)
+    {
+        perror("max6675: history open failed");
+        
+        return 1;
+    }
+    w->samples = 0;
+    w->bytes = 0;
+    a_history_chunk_reset(w);
+    
+    /* a new file gets the header and an old one must have it */
+    size = lseek(w->fd, 0, SEEK_END);
+    if (size == 0)
+    {
+        memset(head, 0, sizeof(head));
+        memcpy(head, RASPBERRYPI4B_MAX6675_HISTORY_MAGIC, 8);
+        a_history_put_u32(head + 8, RASPBERRYPI4B_MAX6675_HISTORY_VERSION);
+        if (write(w->fd, head, sizeof(head)) != (ssize_t)sizeof(head))
+        {
+            perror("max6675: history write failed");
+            (void)close(w->fd);
+            w->fd = -1;
+            
+            return 1;
+        }
+        w->bytes += sizeof(head);
+    }
+    else if ((size < RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE) ||
+             (pread(w->fd, head, sizeof(head), 0) != (ssize_t)sizeof(head)) ||
+             (memcmp(head, RASPBERRYPI4B_MAX6675_HISTORY_MAGIC, 8) != 0) ||
+             (a_history_get_u32(head + 8) != RASPBERRYPI4B_MAX6675_HISTORY_VERSION))
+    {
+        (void)fprintf(stderr, "max6675: %s is not a history.\n", path);
+        (void)close(w->fd);
+        w->fd = -1;
+        
+        return 1;
+    }
+    else
+    {
+        /* a crash may have torn the last chunk, cut it so the new chunks stay readable */
+        tail = a_history_tail(w->fd, size);
+        if (tail != size)
+        {
+            if (ftruncate(w->fd, tail) != 0)
+            {
+                perror("max6675: history truncate failed");
+                (void)close(w->fd);
+                w->fd = -1;
+                
+                return 1;
+            }
+            (void)fprintf(stderr, "max6675: %s had a torn tail, %lld bytes are cut.\n",
+                          path, (long long)(size - tail));
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     history writer add a sample
+ * @param[in] *w pointer to a history writer structure
+ * @param[in] tick tick in ms
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a full chunk is written to the file, the samples are only kept in memory before
+ */
+uint8_t raspberrypi4b_max6675_history_write(raspberrypi4b_max6675_history_writer_t *w, uint32_t tick,
+                                            uint16_t raw, uint8_t status)
+{
+    raspberrypi4b_max6675_history_chunk_t *c;
+    uint16_t value;
+    int32_t delta;
+    
+    if ((w == NULL) || (w->fd < 0))
+    {
+        return 1;
+    }
+    
+    c = &w->chunk;
+    value = (uint16_t)(((raw & 0xFFF) << 3) | (status & 0x07));
+    if (c->count == 0)
+    {
+        /* the first sample goes into the header */
+        c->first_tick = tick;
+        c->first = value;
+        w->prev_delta = 0;
+    }
+    else
+    {
+        /* the value rarely moves and the period rarely changes */
+        delta = (int32_t)(tick - w->prev_tick);
+        c->size += a_history_put_varint(w->buf + c->size, (int32_t)value - (int32_t)w->prev_value);
+        c->size += a_history_put_varint(w->buf + c->size, (int32_t)((uint32_t)delta - (uint32_t)w->prev_delta));
+        w->prev_delta = delta;
+    }
+    w->prev_tick = tick;
+    w->prev_value = value;
+    c->last_tick = tick;
+    c->count++;
+    if (status != 0)
+    {
+        c->faults++;
+    }
+    else
+    {
+        c->min = (raw < c->min) ? raw : c->min;
+        c->max = (raw > c->max) ? raw : c->max;
+    }
+    w->samples++;
+    
+    /* a full chunk is written at once */
+    if (c->count >= RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES)
+    {
+        return raspberrypi4b_max6675_history_flush(w);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     history writer write the open chunk
+ * @param[in] *w pointer to a history writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      every flush ends a chunk, so flush seldom
+ */
+uint8_t raspberrypi4b_max6675_history_flush(raspberrypi4b_max6675_history_writer_t *w)
+{
+    uint8_t head[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE];
+    struct iovec iov[2];
+    raspberrypi4b_max6675_history_chunk_t *c;
+    ssize_t len;
+    
+    if ((w == NULL) || (w->fd < 0))
+    {
+        return 1;
+    }
+    c = &w->chunk;
+    if (c->count == 0)
+    {
+        return 0;
+    }
+    
+    /* header and payload in one append */
+    a_history_put_u32(head + 0, c->size);
+    a_history_put_u32(head + 4, c->count);
+    a_history_put_u32(head + 8, c->first_tick);
+    a_history_put_u32(head + 12, c->last_tick);
+    a_history_put_u16(head + 16, c->min);
+    a_history_put_u16(head + 18, c->max);
+    a_history_put_u16(head + 20, c->first);
+    a_history_put_u16(head + 22, c->faults);
+    iov[0].iov_base = head;
+    iov[0].iov_len = sizeof(head);
+    iov[1].iov_base = w->buf;
+    iov[1].iov_len = c->size;
+    len = writev(w->fd, iov, 2);
+    if (len != (ssize_t)(sizeof(head) + c->size))
+    {
+        perror("max6675: history write failed");
+        
+        return 1;
+    }
+    w->bytes += (uint64_t)len;
+    a_history_chunk_reset(w);
+    
+    return 0;
+}
+
+/**
+ * @brief     history writer close
+ * @param[in] *w pointer to a history writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the open chunk is written first
+ */
+uint8_t raspberrypi4b_max6675_history_close(raspberrypi4b_max6675_history_writer_t *w)
+{
+    uint8_t res;
+    
+    if ((w == NULL) || (w->fd < 0))
+    {
+        return 1;
+    }
+    
+    res = raspberrypi4b_max6675_history_flush(w);
+    if (close(w->fd) != 0)
+    {
+        res = 1;
+    }
+    w->fd = -1;
+    
+    return res;
+}
+
+/**
+ * @brief     history reader open
+ * @param[in] *r pointer to a history reader structure
+ * @param[in] *path pointer to a history file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the history is memory mapped and read in place
+ */
+uint8_t raspberrypi4b_max6675_history_reader_open(raspberrypi4b_max6675_history_reader_t *r, const char *path)
+{
+    struct stat st;
+    void *map;
+    
+    if ((r == NULL) || (path == NULL))
+    {
+        return 1;
+    }
+    memset(r, 0, sizeof(raspberrypi4b_max6675_history_reader_t));
+    
+    r->fd = open(path, O_RDONLY);
+    if (r->fd < 0)
+    {
+        perror("max6675: history open failed");
+        
+        return 1;
+    }
+    if ((fstat(r->fd, &st) != 0) || (st.st_size < RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE))
+    {
+        (void)fprintf(stderr, "max6675: %s is not a history.\n", path);
+        (void)close(r->fd);
+        
+        return 1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("max6675: history mmap failed");
+        (void)close(r->fd);
+        
+        return 1;
+    }
+    r->map = (const uint8_t *)map;
+    r->size = (size_t)st.st_size;
+    r->off = RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE;
+    
+    /* check the header */
+    if ((memcmp(r->map, RASPBERRYPI4B_MAX6675_HISTORY_MAGIC, 8) != 0) ||
+        (a_history_get_u32(r->map + 8) != RASPBERRYPI4B_MAX6675_HISTORY_VERSION))
+    {
+        (void)fprintf(stderr, "max6675: %s is not a history.\n", path);
+        (void)raspberrypi4b_max6675_history_reader_close(r);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      history reader get the next chunk
+ * @param[in]  *r pointer to a history reader structure
+ * @param[out] *chunk pointer to a chunk header buffer
+ * @param[out] **payload pointer to a payload pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no more chunks
+ * @note       only the header is read, so the chunks out of the wanted time or temperature range
+ *             are skipped without touching their payload, a torn chunk at the end is ignored
+ */
+uint8_t raspberrypi4b_max6675_history_reader_next(raspberrypi4b_max6675_history_reader_t *r,
+                                                  raspberrypi4b_max6675_history_chunk_t *chunk,
+                                                  const uint8_t **payload)
+{
+    const uint8_t *p;
+    
+    if ((r == NULL) || (r->map == NULL) ||
+        ((r->off + RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE) > r->size))
+    {
+        return 1;
+    }
+    
+    p = r->map + r->off;
+    chunk->size = a_history_get_u32(p + 0);
+    chunk->count = a_history_get_u32(p + 4);
+    chunk->first_tick = a_history_get_u32(p + 8);
+    chunk->last_tick = a_history_get_u32(p + 12);
+    chunk->min = a_history_get_u16(p + 16);
+    chunk->max = a_history_get_u16(p + 18);
+    chunk->first = a_history_get_u16(p + 20);
+    chunk->faults = a_history_get_u16(p + 22);
+    if ((chunk->count == 0) || (chunk->count > RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES) ||
+        (chunk->size > (r->size - r->off - RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE)))
+    {
+        return 1;
+    }
+    *payload = p + RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE;
+    r->off += RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_HEADER_SIZE + chunk->size;
+    
+    return 0;
+}
+
+/**
+ * @brief     history reader rewind to the first chunk
+ * @param[in] *r pointer to a history reader structure
+ * @note      none
+ */
+void raspberrypi4b_max6675_history_reader_rewind(raspberrypi4b_max6675_history_reader_t *r)
+{
+    r->off = RASPBERRYPI4B_MAX6675_HISTORY_HEADER_SIZE;
+}
+
+/**
+ * @brief     history reader close
+ * @param[in] *r pointer to a history reader structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_history_reader_close(raspberrypi4b_max6675_history_reader_t *r)
+{
+    uint8_t res = 0;
+    
+    if (r == NULL)
+    {
+        return 1;
+    }
+    if (r->map != NULL)
+    {
+        res |= (munmap((void *)r->map, r->size) != 0) ? 1 : 0;
+        r->map = NULL;
+    }
+    if (r->fd >= 0)
+    {
+        res |= (close(r->fd) != 0) ? 1 : 0;
+        r->fd = -1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      history decode a chunk
+ * @param[in]  *chunk pointer to a chunk header
+ * @param[in]  *payload pointer to the chunk payload
+ * @param[out] *tick pointer to a tick buffer with chunk->count entries
+ * @param[out] *raw pointer to a raw buffer with chunk->count entries
+ * @param[out] *status pointer to a status buffer with chunk->count entries
+ * @return     status code
+ *             - 0 success
+ *             - 1 chunk is malformed
+ * @note       none
+ */
+uint8_t raspberrypi4b_max6675_history_decode(const raspberrypi4b_max6675_history_chunk_t *chunk, const uint8_t *payload,
+                                             uint32_t *tick, uint16_t *raw, uint8_t *status)
+{
+    const uint8_t *p = payload;
+    const uint8_t *end = payload + chunk->size;
+    uint32_t value = chunk->first;
+    uint32_t t = chunk->first_tick;
+    int32_t delta = 0;
+    int32_t v;
+    uint32_t n;
+    uint32_t i;
+    
+    for (i = 0; i < chunk->count; i++)
+    {
+        if ((i != 0) && ((p + 1) < end) && (((p[0] | p[1]) & 0x80) == 0))
+        {
+            /* the common sample is two one byte varints */
+            value += (uint32_t)((p[0] >> 1) ^ (0U - (p[0] & 1)));
+            delta = (int32_t)((uint32_t)delta + ((p[1] >> 1) ^ (0U - (p[1] & 1))));
+            t += (uint32_t)delta;
+            p += 2;
+        }
+        else if (i != 0)
+        {
+            n = a_history_get_varint(p, end, &v);
+            if (n == 0)
+            {
+                return 1;
+            }
+            p += n;
+            value += (uint32_t)v;
+            n = a_history_get_varint(p, end, &v);
+            if (n == 0)
+            {
+                return 1;
+            }
+            p += n;
+            delta = (int32_t)((uint32_t)delta + (uint32_t)v);
+            t += (uint32_t)delta;
+        }
+        tick[i] = t;
+        raw[i] = (uint16_t)((value >> 3) & 0xFFF);
+        status[i] = (uint8_t)(value & 0x07);
+    }
+    
+    return (p == end) ? 0 : 1;
+}
@@ -34,9 +34,9 @@
  * </table>
  */
 
-#include "driver_max6675_interface.h"
-#include "spi.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief spi device name definition
@@ -44,46 +44,341 @@
 #define SPI_DEVICE_NAME "/dev/spidev0.0"    /**< spi device name */
 
 /**
- * @brief spi device handle definition
+ * @brief default device definition
  */
-static int gs_fd;                           /**< spi handle */
+static raspberrypi4b_max6675_device_t gs_device =
+{
+    .name = SPI_DEVICE_NAME,
+    .freq = 1000 * 1000,
+    .fd = -1,
+};                                          /**< spidev of the default device */
 
 /**
- * @brief  interface spi bus init
- * @return status code
- *         - 0 success
- *         - 1 spi init failed
- * @note   none
+ * @brief link structure definition
+ */
+typedef struct link_s
+{
+    uint8_t (*spi_init)(void *ctx);                                                      /**< point to a spi_init function address */
+    uint8_t (*spi_deinit)(void *ctx);                                                    /**< point to a spi_deinit function address */
+    uint8_t (*spi_read_cmd)(void *ctx, uint8_t *buf, uint16_t len);                      /**< point to a spi_read_cmd function address */
+    uint8_t (*spi_read_many_cmd)(void *ctx, uint8_t *buf, uint16_t len, uint16_t num);   /**< point to a spi_read_many_cmd function address */
+    void *ctx;                                                                           /**< context of the link functions */
+} link_t;
+
+/**
+ * @brief default device link definition
  */
-uint8_t max6675_interface_spi_init(void)
+static link_t gs_bus =
+{
+    .spi_init = raspberrypi4b_max6675_spidev_spi_init,
+    .spi_deinit = raspberrypi4b_max6675_spidev_spi_deinit,
+    .spi_read_cmd = raspberrypi4b_max6675_spidev_spi_read_cmd,
+    .spi_read_many_cmd = raspberrypi4b_max6675_spidev_spi_read_many_cmd,
+    .ctx = &gs_device,
+};                                          /**< spidev, simulator or replay bus */
+static link_t gs_link =
 {
-    return spi_init(SPI_DEVICE_NAME, &gs_fd, SPI_MODE_TYPE_0, 1000 * 1000);
+    .spi_init = raspberrypi4b_max6675_spidev_spi_init,
+    .spi_deinit = raspberrypi4b_max6675_spidev_spi_deinit,
+    .spi_read_cmd = raspberrypi4b_max6675_spidev_spi_read_cmd,
+    .spi_read_many_cmd = raspberrypi4b_max6675_spidev_spi_read_many_cmd,
+    .ctx = &gs_device,
+};                                          /**< the bus or a capture of it, run by the interface */
+static raspberrypi4b_max6675_capture_t *gs_capture = NULL;        /**< capture of the default device */
+
+/**
+ * @brief wait statistics definition
+ */
+static periodic_t gs_wait;                  /**< wait_until_ms lateness */
+
+/**
+ * @brief simulator clock definition
+ */
+static uint8_t gs_sim_clock = 0;            /**< 1 follows the simulator clock */
+
+/**
+ * @brief     set the bus of the default device
+ * @param[in] init pointer to a spi_init function address
+ * @param[in] deinit pointer to a spi_deinit function address
+ * @param[in] read pointer to a spi_read_cmd function address
+ * @param[in] read_many pointer to a spi_read_many_cmd function address
+ * @param[in] *ctx pointer to the context of the functions
+ * @note      a capture of the default device is linked over the new bus
+ */
+static void a_set_bus(uint8_t (*init)(void *), uint8_t (*deinit)(void *),
+                      uint8_t (*read)(void *, uint8_t *, uint16_t),
+                      uint8_t (*read_many)(void *, uint8_t *, uint16_t, uint16_t), void *ctx)
+{
+    gs_bus.spi_init = init;
+    gs_bus.spi_deinit = deinit;
+    gs_bus.spi_read_cmd = read;
+    gs_bus.spi_read_many_cmd = read_many;
+    gs_bus.ctx = ctx;
+    if (gs_capture == NULL)
+    {
+        gs_link = gs_bus;
+        
+        return;
+    }
+    
+    /* the capture records the frames of the bus */
+    RASPBERRYPI4B_MAX6675_CAPTURE_LINK(gs_capture, init, deinit, read, read_many, ctx);
+    RASPBERRYPI4B_MAX6675_CAPTURE_LINK_GET_TICK_MS(gs_capture, max6675_interface_get_tick_ms);
+    gs_link.spi_init = raspberrypi4b_max6675_capture_spi_init;
+    gs_link.spi_deinit = raspberrypi4b_max6675_capture_spi_deinit;
+    gs_link.spi_read_cmd = raspberrypi4b_max6675_capture_spi_read_cmd;
+    gs_link.spi_read_many_cmd = raspberrypi4b_max6675_capture_spi_read_many_cmd;
+    gs_link.ctx = gs_capture;
 }
 
 /**
- * @brief  interface spi bus deinit
- * @return status code
- *         - 0 success
- *         - 1 spi deinit failed
- * @note   none
+ * @brief     spidev spi bus init
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the spidev is opened and the frame read is prepared once
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_init(void *ctx)
+{
+    raspberrypi4b_max6675_device_t *dev = (raspberrypi4b_max6675_device_t *)ctx;
+    
+    if (dev == NULL)
+    {
+        return 1;
+    }
+    if (spi_init(dev->name, &dev->fd, SPI_MODE_TYPE_0, dev->freq) != 0)
+    {
+        return 1;
+    }
+    
+    /* prepare the frame read once */
+    if ((spi_prepared_init(&dev->read, dev->fd, 0) != 0) ||
+        (spi_prepared_add(&dev->read, NULL, NULL, 2, 0) != 0))
+    {
+        (void)spi_deinit(dev->fd);
+        dev->fd = -1;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spidev spi bus deinit
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_deinit(void *ctx)
+{
+    raspberrypi4b_max6675_device_t *dev = (raspberrypi4b_max6675_device_t *)ctx;
+    uint8_t res;
+    
+    if (dev == NULL)
+    {
+        return 1;
+    }
+    
+    res = spi_deinit(dev->fd);
+    dev->fd = -1;
+    
+    return res;
+}
+
+/**
+ * @brief      spidev spi bus read
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a frame read runs the prepared transaction into buf without any setup
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_max6675_device_t *dev = (raspberrypi4b_max6675_device_t *)ctx;
+    
+    if (dev == NULL)
+    {
+        return 1;
+    }
+    if (len != 2)
+    {
+        return spi_read_cmd(dev->fd, buf, len);
+    }
+    
+    /* run the prepared frame read */
+    (void)spi_prepared_set_buffer(&dev->read, 0, NULL, buf);
+    
+    return spi_prepared_run(&dev->read);
+}
+
+/**
+ * @brief      spidev spi bus read many
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a spidev device has one cs and one chip and one SPI_IOC_MESSAGE can not span the
+ *             cs lines of other spidev nodes, so it only reads a single frame and fails with
+ *             num > 1 instead of giving the other devices the frame of this chip
+ */
+uint8_t raspberrypi4b_max6675_spidev_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    if (num != 1)
+    {
+        return 1;
+    }
+    
+    return raspberrypi4b_max6675_spidev_spi_read_cmd(ctx, buf, len);
+}
+
+/**
+ * @brief     fanout spi bus init
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the fanout owns the bus, so only the device is checked
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_init(void *ctx)
+{
+    raspberrypi4b_max6675_fanout_device_t *dev = (raspberrypi4b_max6675_fanout_device_t *)ctx;
+    
+    return ((dev != NULL) && (dev->fanout != NULL)) ? 0 : 1;
+}
+
+/**
+ * @brief     fanout spi bus deinit
+ * @param[in] *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the fanout owns the bus and stays open
  */
-uint8_t max6675_interface_spi_deinit(void)
-{   
-    return spi_deinit(gs_fd);
+uint8_t raspberrypi4b_max6675_fanout_spi_deinit(void *ctx)
+{
+    return (ctx != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief      fanout spi bus read
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the gpio cs line of the device is selected around the transfer
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_max6675_fanout_device_t *dev = (raspberrypi4b_max6675_fanout_device_t *)ctx;
+    
+    if (dev == NULL)
+    {
+        return 1;
+    }
+    
+    return spi_fanout_read(dev->fanout, dev->line, buf, len);
+}
+
+/**
+ * @brief      fanout spi bus read many
+ * @param[in]  *ctx pointer to a raspberrypi4b max6675 fanout device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       fanout lines 0 to num - 1 are read with batched gpio cs sets
+ */
+uint8_t raspberrypi4b_max6675_fanout_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    raspberrypi4b_max6675_fanout_device_t *dev = (raspberrypi4b_max6675_fanout_device_t *)ctx;
+    
+    if (dev == NULL)
+    {
+        return 1;
+    }
+    
+    return spi_fanout_read_many(dev->fanout, buf, len, num);
+}
+
+/**
+ * @brief     interface spi bus init
+ * @param[in] *ctx pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the interface functions run the default device, ctx is not used
+ */
+uint8_t max6675_interface_spi_init(void *ctx)
+{
+    (void)ctx;
+    
+    return gs_link.spi_init(gs_link.ctx);
+}
+
+/**
+ * @brief     interface spi bus deinit
+ * @param[in] *ctx pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the interface functions run the default device, ctx is not used
+ */
+uint8_t max6675_interface_spi_deinit(void *ctx)
+{
+    (void)ctx;
+    
+    return gs_link.spi_deinit(gs_link.ctx);
 }
 
 /**
  * @brief      interface spi bus read
+ * @param[in]  *ctx pointer to a user context
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len length of data buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the default device reads its spidev, simulator or replay bus, through its capture
+ *             when one is set
  */
-uint8_t max6675_interface_spi_read_cmd(uint8_t *buf, uint16_t len)
+uint8_t max6675_interface_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
 {
-    return spi_read_cmd(gs_fd, buf, len);
+    (void)ctx;
+    
+    return gs_link.spi_read_cmd(gs_link.ctx, buf, len);
+}
+
+/**
+ * @brief      interface spi bus read many command
+ * @param[in]  *ctx pointer to a user context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the default device is a single spidev chip, so only a simulator list or a replay
+ *             bus can read num > 1 frames
+ */
+uint8_t max6675_interface_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    (void)ctx;
+    
+    return gs_link.spi_read_many_cmd(gs_link.ctx, buf, len, num);
 }
 
 /**
@@ -93,9 +388,122 @@ uint8_t max6675_interface_spi_read_cmd(uint8_t *buf, uint16_t len)
  */
 void max6675_interface_delay_ms(uint32_t ms)
 {
+    if (gs_sim_clock != 0)
+    {
+        raspberrypi4b_max6675_sim_delay_ms(ms);
+        
+        return;
+    }
+    
     usleep(1000 * ms);
 }
 
+/**
+ * @brief  interface get tick ms
+ * @return monotonic tick in ms
+ * @note   none
+ */
+uint32_t max6675_interface_get_tick_ms(void)
+{
+    struct timespec t;
+    
+    if (gs_sim_clock != 0)
+    {
+        return raspberrypi4b_max6675_sim_get_tick_ms();
+    }
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint32_t)((uint64_t)t.tv_sec * 1000 + (uint64_t)t.tv_nsec / 1000000);
+}
+
+/**
+ * @brief     interface wait until a tick
+ * @param[in] tick absolute get_tick_ms tick
+ * @note      the tick is widened against the current time and slept to with clock_nanosleep
+ *            TIMER_ABSTIME, so the wake up does not depend on when the call is made
+ */
+void max6675_interface_wait_until_ms(uint32_t tick)
+{
+    uint64_t now_ms;
+    uint64_t deadline_ms;
+    
+    if (gs_sim_clock != 0)
+    {
+        raspberrypi4b_max6675_sim_wait_until_ms(tick);
+        
+        return;
+    }
+    
+    now_ms = periodic_now_ns() / 1000000ULL;
+    deadline_ms = now_ms + (int64_t)(int32_t)(tick - (uint32_t)now_ms);
+    (void)periodic_wait_until(&gs_wait, deadline_ms * 1000000ULL);
+}
+
+/**
+ * @brief     run the default device on a simulator
+ * @param[in] *sim pointer to an inited simulator structure, NULL goes back to the bus
+ * @note      the delay, tick and wait interface functions follow the simulator clock too,
+ *            so the driver test runs unchanged on the virtual clock
+ */
+void raspberrypi4b_max6675_set_sim(raspberrypi4b_max6675_sim_t *sim)
+{
+    if (sim != NULL)
+    {
+        a_set_bus(raspberrypi4b_max6675_sim_spi_init, raspberrypi4b_max6675_sim_spi_deinit,
+                  raspberrypi4b_max6675_sim_spi_read_cmd, raspberrypi4b_max6675_sim_spi_read_many_cmd, sim);
+    }
+    else
+    {
+        a_set_bus(raspberrypi4b_max6675_spidev_spi_init, raspberrypi4b_max6675_spidev_spi_deinit,
+                  raspberrypi4b_max6675_spidev_spi_read_cmd, raspberrypi4b_max6675_spidev_spi_read_many_cmd, &gs_device);
+    }
+    gs_sim_clock = (sim != NULL) ? 1 : 0;
+}
+
+/**
+ * @brief     run the default device on a trace
+ * @param[in] *replay pointer to an opened replay structure, NULL goes back to the bus
+ * @note      the clock is not changed, the replay paces the frames itself
+ */
+void raspberrypi4b_max6675_set_replay(raspberrypi4b_max6675_replay_t *replay)
+{
+    if (replay != NULL)
+    {
+        a_set_bus(raspberrypi4b_max6675_replay_spi_init, raspberrypi4b_max6675_replay_spi_deinit,
+                  raspberrypi4b_max6675_replay_spi_read_cmd, raspberrypi4b_max6675_replay_spi_read_many_cmd, replay);
+    }
+    else
+    {
+        a_set_bus(raspberrypi4b_max6675_spidev_spi_init, raspberrypi4b_max6675_spidev_spi_deinit,
+                  raspberrypi4b_max6675_spidev_spi_read_cmd, raspberrypi4b_max6675_spidev_spi_read_many_cmd, &gs_device);
+    }
+}
+
+/**
+ * @brief     capture every frame read from the default device
+ * @param[in] *capture pointer to an opened capture structure, NULL stops the capture
+ * @note      the capture is linked over the bus of the default device
+ */
+void raspberrypi4b_max6675_set_capture(raspberrypi4b_max6675_capture_t *capture)
+{
+    gs_capture = capture;
+    a_set_bus(gs_bus.spi_init, gs_bus.spi_deinit, gs_bus.spi_read_cmd, gs_bus.spi_read_many_cmd, gs_bus.ctx);
+}
+
+/**
+ * @brief      get the wait statistics
+ * @param[out] *stats pointer to a periodic statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the lateness of every max6675_interface_wait_until_ms wake up is recorded
+ */
+uint8_t raspberrypi4b_max6675_get_wait_stats(periodic_stats_t *stats)
+{
+    return periodic_get_stats(&gs_wait, stats);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
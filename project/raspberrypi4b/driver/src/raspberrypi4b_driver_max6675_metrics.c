@@ -0,0 +1,621 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_metrics.c
+ * @brief     raspberrypi4b driver max6675 metrics source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "raspberrypi4b_driver_max6675_metrics.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * @brief metrics definition
+ */
+#define METRICS_LISTEN_ID        RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS        /**< epoll id of the listening socket */
+#define METRICS_MAX_EVENTS       8                                                /**< events handled per wait */
+
+/**
+ * @brief latency bucket definition
+ */
+static const uint64_t gs_bucket_ns[RASPBERRYPI4B_MAX6675_METRICS_BUCKETS - 1] =
+{
+    100000ULL, 250000ULL, 500000ULL, 1000000ULL, 2500000ULL,
+    5000000ULL, 10000000ULL, 25000000ULL, 100000000ULL, 250000000ULL,
+};                                                                                       /**< upper bounds */
+static const char *const gs_bucket_le[RASPBERRYPI4B_MAX6675_METRICS_BUCKETS] =
+{
+    "0.0001", "0.00025", "0.0005", "0.001", "0.0025",
+    "0.005", "0.01", "0.025", "0.1", "0.25", "+Inf",
+};                                                                                       /**< le labels */
+
+/**
+ * @brief not found response definition
+ */
+static const char gs_not_found[] = "HTTP/1.1 404 Not Found\r\n"
+                                   "Content-Type: text/plain; charset=utf-8\r\n"
+                                   "Content-Length: 10\r\n"
+                                   "Connection: close\r\n"
+                                   "\r\n"
+                                   "not found\n";                                        /**< every other path */
+
+/**
+ * @brief      append formatted text
+ * @param[out] *buf pointer to a text buffer of RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE bytes
+ * @param[in]  *len pointer to a text length
+ * @param[in]  *fmt pointer to a format string
+ * @note       the text is cut at the end of the buffer
+ */
+static void a_metrics_append(char *buf, uint32_t *len, const char *fmt, ...)
+{
+    va_list args;
+    int n;
+    
+    if (*len >= RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE)
+    {
+        return;
+    }
+    va_start(args, fmt);
+    n = vsnprintf(buf + *len, RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE - *len, fmt, args);
+    va_end(args);
+    if (n > 0)
+    {
+        *len += (uint32_t)n;
+    }
+}
+
+/**
+ * @brief     append one counter family
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] *len pointer to a body length
+ * @param[in] *name pointer to a family name
+ * @param[in] *help pointer to a help text
+ * @param[in] offset offset of the uint32 counter in max6675_stats_t
+ * @note      none
+ */
+static void a_metrics_counter(raspberrypi4b_max6675_metrics_t *metrics, uint32_t *len,
+                              const char *name, const char *help, size_t offset)
+{
+    uint32_t i;
+    
+    a_metrics_append(metrics->body, len, "# TYPE %s counter\n# HELP %s %s\n", name, name, help);
+    for (i = 0; i < metrics->num; i++)
+    {
+        uint32_t v;
+        
+        memcpy(&v, (const uint8_t *)&metrics->sensor[i].stats + offset, sizeof(uint32_t));
+        a_metrics_append(metrics->body, len, "%s_total{sensor=\"%u\"} %u\n", name, i, v);
+    }
+}
+
+/**
+ * @brief     render the response
+ * @param[in] *metrics pointer to a metrics structure
+ * @note      none
+ */
+static void a_metrics_render(raspberrypi4b_max6675_metrics_t *metrics)
+{
+    raspberrypi4b_max6675_metrics_sensor_t *s;
+    uint32_t body;
+    uint32_t head;
+    uint32_t i;
+    uint32_t j;
+    
+    metrics->dirty = 0;
+    body = 0;
+    a_metrics_append(metrics->body, &body,
+                     "# TYPE max6675_temperature_celsius gauge\n"
+                     "# UNIT max6675_temperature_celsius celsius\n"
+                     "# HELP max6675_temperature_celsius Latest good thermocouple temperature.\n");
+    for (i = 0; i < metrics->num; i++)
+    {
+        s = &metrics->sensor[i];
+        if (s->valid != 0)
+        {
+            a_metrics_append(metrics->body, &body, "max6675_temperature_celsius{sensor=\"%u\"} %u.%02u\n",
+                             i, (uint32_t)s->raw / 4, ((uint32_t)s->raw % 4) * 25);
+        }
+    }
+    a_metrics_append(metrics->body, &body,
+                     "# TYPE max6675_open_circuit gauge\n"
+                     "# HELP max6675_open_circuit 1 while the thermocouple input is open.\n");
+    for (i = 0; i < metrics->num; i++)
+    {
+        a_metrics_append(metrics->body, &body, "max6675_open_circuit{sensor=\"%u\"} %u\n",
+                         i, (metrics->sensor[i].status == 4) ? 1 : 0);
+    }
+    a_metrics_append(metrics->body, &body,
+                     "# TYPE max6675_read_status gauge\n"
+                     "# HELP max6675_read_status Latest max6675_read status code, 0 is ok.\n");
+    for (i = 0; i < metrics->num; i++)
+    {
+        a_metrics_append(metrics->body, &body, "max6675_read_status{sensor=\"%u\"} %u\n", i, metrics->sensor[i].status);
+    }
+    a_metrics_append(metrics->body, &body, "# TYPE max6675_reads counter\n# HELP max6675_reads Temperature reads.\n");
+    for (i = 0; i < metrics->num; i++)
+    {
+        a_metrics_append(metrics->body, &body, "max6675_reads_total{sensor=\"%u\"} %llu\n", i,
+                         (unsigned long long)metrics->sensor[i].reads);
+    }
+    a_metrics_counter(metrics, &body, "max6675_spi_errors", "Failed spi transfers.", offsetof(max6675_stats_t, spi_fail));
+    a_metrics_counter(metrics, &body, "max6675_open_faults", "Reads with an open thermocouple input.", offsetof(max6675_stats_t, open));
+    a_metrics_counter(metrics, &body, "max6675_corrupt_frames", "Frames with a bad fixed bit.", offsetof(max6675_stats_t, corrupt));
+    a_metrics_counter(metrics, &body, "max6675_read_retries", "Reads that were retried.", offsetof(max6675_stats_t, retry));
+    a_metrics_append(metrics->body, &body,
+                     "# TYPE max6675_read_latency_seconds histogram\n"
+                     "# UNIT max6675_read_latency_seconds seconds\n"
+                     "# HELP max6675_read_latency_seconds Time of one temperature read.\n");
+    for (i = 0; i < metrics->num; i++)
+    {
+        uint64_t count;
+        
+        s = &metrics->sensor[i];
+        count = 0;
+        for (j = 0; j < RASPBERRYPI4B_MAX6675_METRICS_BUCKETS; j++)
+        {
+            count += s->bucket[j];
+            a_metrics_append(metrics->body, &body, "max6675_read_latency_seconds_bucket{sensor=\"%u\",le=\"%s\"} %llu\n",
+                             i, gs_bucket_le[j], (unsigned long long)count);
+        }
+        a_metrics_append(metrics->body, &body, "max6675_read_latency_seconds_count{sensor=\"%u\"} %llu\n"
+                         "max6675_read_latency_seconds_sum{sensor=\"%u\"} %llu.%09llu\n",
+                         i, (unsigned long long)count, i,
+                         (unsigned long long)(s->sum_ns / 1000000000ULL), (unsigned long long)(s->sum_ns % 1000000000ULL));
+    }
+    a_metrics_append(metrics->body, &body, "# EOF\n");
+    if (body > RASPBERRYPI4B_MAX6675_METRICS_RESPONSE_SIZE - 256)
+    {
+        /* a cut body is no valid exposition, keep the old response */
+        return;
+    }
+    
+    /* the header and the body in one buffer */
+    head = 0;
+    a_metrics_append(metrics->response, &head,
+                     "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                     "Content-Length: %u\r\n"
+                     "Connection: close\r\n"
+                     "\r\n", body);
+    memcpy(metrics->response + head, metrics->body, body);
+    metrics->len = head + body;
+    metrics->renders++;
+}
+
+/**
+ * @brief     close a client
+ * @param[in] *client pointer to a client structure
+ * @note      closing the socket removes it from the epoll set
+ */
+static void a_metrics_drop(raspberrypi4b_max6675_metrics_client_t *client)
+{
+    (void)close(client->fd);
+    client->fd = -1;
+}
+
+/**
+ * @brief     send the response of a client
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] index client index
+ * @return    status code
+ *            - 0 success
+ *            - 1 client is done or failed
+ * @note      a full socket waits for EPOLLOUT
+ */
+static uint8_t a_metrics_send(raspberrypi4b_max6675_metrics_t *metrics, uint32_t index)
+{
+    raspberrypi4b_max6675_metrics_client_t *client = &metrics->client[index];
+    struct epoll_event ev;
+    ssize_t n;
+    
+    while (client->sent < client->size)
+    {
+        n = send(client->fd, client->response + client->sent, client->size - client->sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                ev.events = EPOLLOUT;
+                ev.data.u32 = index;
+                
+                return (epoll_ctl(metrics->epfd, EPOLL_CTL_MOD, client->fd, &ev) != 0) ? 1 : 0;
+            }
+            
+            return 1;
+        }
+        client->sent += (uint32_t)n;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     read the request of a client
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] index client index
+ * @return    status code
+ *            - 0 success
+ *            - 1 client is done or failed
+ * @note      the response is rendered if a sample came after the last render and copied when the
+ *            request head is complete, so a later render can not change a response that is being sent
+ */
+static uint8_t a_metrics_receive(raspberrypi4b_max6675_metrics_t *metrics, uint32_t index)
+{
+    raspberrypi4b_max6675_metrics_client_t *client = &metrics->client[index];
+    ssize_t n;
+    
+    while (1)
+    {
+        n = read(client->fd, client->request + client->len, sizeof(client->request) - 1 - client->len);
+        if (n == 0)
+        {
+            return 1;
+        }
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : 1;
+        }
+        client->len += (uint32_t)n;
+        client->request[client->len] = '\0';
+        if ((strstr(client->request, "\r\n\r\n") != NULL) || (strstr(client->request, "\n\n") != NULL))
+        {
+            break;
+        }
+        if (client->len >= sizeof(client->request) - 1)
+        {
+            return 1;
+        }
+    }
+    
+    /* only the metrics path is served, the response is rendered once per change */
+    if ((strncmp(client->request, "GET /metrics", 12) == 0) &&
+        ((client->request[12] == ' ') || (client->request[12] == '?')) && (metrics->dirty != 0))
+    {
+        a_metrics_render(metrics);
+    }
+    if ((strncmp(client->request, "GET /metrics", 12) == 0) &&
+        ((client->request[12] == ' ') || (client->request[12] == '?')) && (metrics->len != 0))
+    {
+        memcpy(client->response, metrics->response, metrics->len);
+        client->size = metrics->len;
+        metrics->scrapes++;
+    }
+    else
+    {
+        memcpy(client->response, gs_not_found, sizeof(gs_not_found) - 1);
+        client->size = sizeof(gs_not_found) - 1;
+    }
+    client->sent = 0;
+    
+    return a_metrics_send(metrics, index);
+}
+
+/**
+ * @brief     accept the waiting clients
+ * @param[in] *metrics pointer to a metrics structure
+ * @note      a client over RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS is closed at once
+ */
+static void a_metrics_accept(raspberrypi4b_max6675_metrics_t *metrics)
+{
+    struct epoll_event ev;
+    uint32_t i;
+    int fd;
+    
+    while (1)
+    {
+        fd = accept4(metrics->fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        for (i = 0; i < RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS; i++)
+        {
+            if (metrics->client[i].fd < 0)
+            {
+                break;
+            }
+        }
+        if (i == RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u32 = i;
+        if (epoll_ctl(metrics->epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        metrics->client[i].fd = fd;
+        metrics->client[i].len = 0;
+        metrics->client[i].sent = 0;
+        metrics->client[i].size = 0;
+    }
+}
+
+/**
+ * @brief     metrics open the http listener
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] *address pointer to an ipv4 address to bind, NULL binds every interface
+ * @param[in] port tcp port, 0 picks a free one
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the bound port is kept in metrics->port
+ */
+uint8_t raspberrypi4b_max6675_metrics_open(raspberrypi4b_max6675_metrics_t *metrics, const char *address,
+                                           uint16_t port, uint32_t num)
+{
+    struct sockaddr_in addr;
+    socklen_t addr_len;
+    struct epoll_event ev;
+    uint32_t i;
+    int on;
+    
+    if ((metrics == NULL) || (num == 0) || (num > RASPBERRYPI4B_MAX6675_METRICS_MAX_SENSORS))
+    {
+        return 1;
+    }
+    memset(metrics->sensor, 0, sizeof(metrics->sensor));
+    for (i = 0; i < RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS; i++)
+    {
+        metrics->client[i].fd = -1;
+    }
+    metrics->num = num;
+    metrics->scrapes = 0;
+    metrics->renders = 0;
+    metrics->len = 0;
+    metrics->dirty = 0;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if ((address != NULL) && (inet_pton(AF_INET, address, &addr.sin_addr) != 1))
+    {
+        (void)fprintf(stderr, "max6675: %s is not an ipv4 address.\n", address);
+        
+        return 1;
+    }
+    
+    /* listen */
+    metrics->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (metrics->fd < 0)
+    {
+        perror("max6675: socket failed");
+        
+        return 1;
+    }
+    on = 1;
+    (void)setsockopt(metrics->fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    addr_len = sizeof(addr);
+    if ((bind(metrics->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(metrics->fd, SOMAXCONN) != 0) ||
+        (getsockname(metrics->fd, (struct sockaddr *)&addr, &addr_len) != 0))
+    {
+        perror("max6675: metrics bind failed");
+        (void)close(metrics->fd);
+        
+        return 1;
+    }
+    metrics->port = ntohs(addr.sin_port);
+    
+    /* an own epoll set, its handle can be watched by another event loop */
+    metrics->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (metrics->epfd < 0)
+    {
+        perror("max6675: epoll failed");
+        (void)close(metrics->fd);
+        
+        return 1;
+    }
+    ev.events = EPOLLIN;
+    ev.data.u32 = METRICS_LISTEN_ID;
+    if (epoll_ctl(metrics->epfd, EPOLL_CTL_ADD, metrics->fd, &ev) != 0)
+    {
+        perror("max6675: epoll failed");
+        (void)close(metrics->epfd);
+        (void)close(metrics->fd);
+        
+        return 1;
+    }
+    a_metrics_render(metrics);
+    
+    return 0;
+}
+
+/**
+ * @brief     metrics update a sensor
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] index sensor index
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status max6675_read status code
+ * @param[in] latency_ns read time
+ * @param[in] *stats pointer to the driver statistics of the sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ * @note      the sensor is only marked dirty here, the next scrape renders the response once
+ */
+uint8_t raspberrypi4b_max6675_metrics_update(raspberrypi4b_max6675_metrics_t *metrics, uint32_t index, uint16_t raw,
+                                             uint8_t status, uint64_t latency_ns, const max6675_stats_t *stats)
+{
+    raspberrypi4b_max6675_metrics_sensor_t *s;
+    uint32_t j;
+    
+    if ((metrics == NULL) || (stats == NULL) || (index >= metrics->num))
+    {
+        return 1;
+    }
+    
+    s = &metrics->sensor[index];
+    if (status == 0)
+    {
+        s->valid = 1;
+        s->raw = raw;
+    }
+    s->status = status;
+    s->reads++;
+    s->stats = *stats;
+    for (j = 0; j < RASPBERRYPI4B_MAX6675_METRICS_BUCKETS - 1; j++)
+    {
+        if (latency_ns <= gs_bucket_ns[j])
+        {
+            break;
+        }
+    }
+    s->bucket[j]++;
+    s->sum_ns += latency_ns;
+    metrics->dirty = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     metrics serve the scrapes
+ * @param[in] *metrics pointer to a metrics structure
+ * @param[in] timeout_ms longest wait for an event, 0 does not wait
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      GET /metrics gets a response of the latest samples, every other request gets 404, the
+ *            connection is closed after the response, nothing is allocated and the bus is not used
+ */
+uint8_t raspberrypi4b_max6675_metrics_poll(raspberrypi4b_max6675_metrics_t *metrics, int timeout_ms)
+{
+    struct epoll_event ev[METRICS_MAX_EVENTS];
+    raspberrypi4b_max6675_metrics_client_t *client;
+    int n;
+    int i;
+    
+    if (metrics == NULL)
+    {
+        return 1;
+    }
+    
+    n = epoll_wait(metrics->epfd, ev, METRICS_MAX_EVENTS, timeout_ms);
+    if (n < 0)
+    {
+        return (errno == EINTR) ? 0 : 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (ev[i].data.u32 == METRICS_LISTEN_ID)
+        {
+            a_metrics_accept(metrics);
+            
+            continue;
+        }
+        client = &metrics->client[ev[i].data.u32];
+        if (client->fd < 0)
+        {
+            continue;
+        }
+        if ((ev[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+        {
+            a_metrics_drop(client);
+            
+            continue;
+        }
+        if (client->size == 0)
+        {
+            if (a_metrics_receive(metrics, ev[i].data.u32) != 0)
+            {
+                a_metrics_drop(client);
+            }
+        }
+        else
+        {
+            if (a_metrics_send(metrics, ev[i].data.u32) != 0)
+            {
+                a_metrics_drop(client);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     metrics close
+ * @param[in] *metrics pointer to a metrics structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_metrics_close(raspberrypi4b_max6675_metrics_t *metrics)
+{
+    uint8_t res = 0;
+    uint32_t i;
+    
+    if ((metrics == NULL) || (metrics->fd < 0))
+    {
+        return 1;
+    }
+    
+    for (i = 0; i < RASPBERRYPI4B_MAX6675_METRICS_MAX_CLIENTS; i++)
+    {
+        if (metrics->client[i].fd >= 0)
+        {
+            a_metrics_drop(&metrics->client[i]);
+        }
+    }
+    res |= (close(metrics->epfd) != 0) ? 1 : 0;
+    res |= (close(metrics->fd) != 0) ? 1 : 0;
+    metrics->fd = -1;
+    metrics->epfd = -1;
+    
+    return res;
+}
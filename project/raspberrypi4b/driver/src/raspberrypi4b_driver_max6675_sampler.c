@@ -0,0 +1,427 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_sampler.c
+ * @brief     raspberrypi4b driver max6675 sampler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "raspberrypi4b_driver_max6675_sampler.h"
+#include <sched.h>
+#include <time.h>
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_sampler_time_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     push a sample to the queue
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      bounded mpmc queue, every cell carries the position it is ready for so the
+ *            producers only race on one compare and swap of head
+ */
+static uint8_t a_sampler_push(raspberrypi4b_max6675_sampler_t *sampler, const raspberrypi4b_max6675_sample_t *sample)
+{
+    raspberrypi4b_max6675_sampler_cell_t *cell;
+    uint32_t pos;
+    uint32_t seq;
+    int32_t diff;
+    
+    pos = __atomic_load_n(&sampler->head, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        cell = &sampler->cell[pos & sampler->mask];
+        seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        diff = (int32_t)(seq - pos);
+        if (diff == 0)
+        {
+            /* the cell is free, claim it */
+            if (__atomic_compare_exchange_n(&sampler->head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* the consumer is one lap behind, drop the sample */
+            (void)__atomic_fetch_add(&sampler->dropped, 1, __ATOMIC_RELAXED);
+            
+            return 1;
+        }
+        else
+        {
+            pos = __atomic_load_n(&sampler->head, __ATOMIC_RELAXED);
+        }
+    }
+    cell->sample = *sample;
+    
+    /* publish the cell */
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     io thread of one spi controller
+ * @param[in] *arg pointer to a sampler bus structure
+ * @return    NULL
+ * @note      the handles of a controller are read in turn, a controller is one serialized fd
+ */
+static void *a_sampler_thread(void *arg)
+{
+    raspberrypi4b_max6675_sampler_bus_t *bus = (raspberrypi4b_max6675_sampler_bus_t *)arg;
+    raspberrypi4b_max6675_sampler_t *sampler = bus->sampler;
+    raspberrypi4b_max6675_sample_t sample;
+    uint16_t i;
+    
+    while (__atomic_load_n(&sampler->running, __ATOMIC_ACQUIRE) != 0)
+    {
+        for (i = 0; i < bus->num; i++)
+        {
+            /* read the device */
+            sample.index = bus->index[i];
+            sample.bus = bus->bus;
+            sample.raw = 0;
+            sample.temp = 0.0f;
+            sample.status = max6675_read(sampler->handle[sample.index], &sample.raw, &sample.temp);
+            sample.timestamp_ns = a_sampler_time_ns();
+            
+            /* hand it to the consumer */
+            (void)a_sampler_push(sampler, &sample);
+            bus->samples++;
+        }
+        
+        /* wait for the next round */
+        if (sampler->period_ms != 0)
+        {
+            (void)periodic_wait(&bus->periodic);
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] **handle pointer to an inited handle list
+ * @param[in] num handle number
+ * @param[in] *cell pointer to a queue cell buffer
+ * @param[in] size queue cell number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 sampler, handle or cell is NULL
+ *            - 4 size is not a power of 2
+ * @note      the ctx of every handle must be a raspberrypi4b_max6675_device_t, the controller is
+ *            parsed from its /dev/spidevB.C name and every controller gets one io thread
+ */
+uint8_t raspberrypi4b_max6675_sampler_init(raspberrypi4b_max6675_sampler_t *sampler,
+                                           max6675_handle_t **handle, uint16_t num,
+                                           raspberrypi4b_max6675_sampler_cell_t *cell, uint32_t size)
+{
+    uint32_t i;
+    uint32_t j;
+    
+    if ((sampler == NULL) || (handle == NULL) || (cell == NULL))
+    {
+        return 2;
+    }
+    if ((size == 0) || ((size & (size - 1)) != 0))
+    {
+        return 4;
+    }
+    
+    /* reset the sampler */
+    memset(sampler, 0, sizeof(raspberrypi4b_max6675_sampler_t));
+    sampler->handle = handle;
+    sampler->num = num;
+    sampler->cell = cell;
+    sampler->mask = size - 1;
+    for (i = 0; i < size; i++)
+    {
+        cell[i].seq = i;
+    }
+    
+    /* assign the handles to their controllers */
+    for (i = 0; i < num; i++)
+    {
+        raspberrypi4b_max6675_device_t *dev;
+        unsigned int b;
+        unsigned int c;
+        
+        dev = (handle[i] != NULL) ? (raspberrypi4b_max6675_device_t *)handle[i]->ctx : NULL;
+        if ((dev == NULL) || (dev->name == NULL) || (sscanf(dev->name, "/dev/spidev%u.%u", &b, &c) != 2))
+        {
+            max6675_interface_debug_print("sampler: handle %d has no spidev device.\n", i);
+            
+            return 1;
+        }
+        for (j = 0; j < sampler->bus_num; j++)
+        {
+            if (sampler->bus[j].bus == b)
+            {
+                break;
+            }
+        }
+        if (j == sampler->bus_num)
+        {
+            if (sampler->bus_num >= RASPBERRYPI4B_MAX6675_SAMPLER_MAX_BUS)
+            {
+                max6675_interface_debug_print("sampler: too many controllers.\n");
+                
+                return 1;
+            }
+            sampler->bus[j].sampler = sampler;
+            sampler->bus[j].bus = (uint8_t)b;
+            sampler->bus[j].cpu = -1;
+            sampler->bus_num++;
+        }
+        if (sampler->bus[j].num >= RASPBERRYPI4B_MAX6675_SAMPLER_MAX_DEVICE)
+        {
+            max6675_interface_debug_print("sampler: too many devices on spidev%d.\n", b);
+            
+            return 1;
+        }
+        sampler->bus[j].index[sampler->bus[j].num++] = (uint16_t)i;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler start
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] period_ms round period, 0 reads as fast as the bus allows
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 sampler is NULL
+ * @note      io thread i is pinned to cpu i modulo the online cpus, a failed pinning is not an error,
+ *            the rounds start on absolute deadlines so the read time does not stretch the period
+ */
+uint8_t raspberrypi4b_max6675_sampler_start(raspberrypi4b_max6675_sampler_t *sampler, uint32_t period_ms)
+{
+    long cpus;
+    uint8_t i;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (sampler->running != 0)
+    {
+        return 1;
+    }
+    
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    sampler->period_ms = period_ms;
+    __atomic_store_n(&sampler->running, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < sampler->bus_num; i++)
+    {
+        raspberrypi4b_max6675_sampler_bus_t *bus = &sampler->bus[i];
+        
+        bus->samples = 0;
+        (void)periodic_init(&bus->periodic, (uint64_t)period_ms * 1000000ULL);
+        if (pthread_create(&bus->thread, NULL, a_sampler_thread, bus) != 0)
+        {
+            perror("sampler: create thread failed.\n");
+            (void)raspberrypi4b_max6675_sampler_stop(sampler);
+            
+            return 1;
+        }
+        bus->started = 1;
+        
+        /* pin the thread */
+        bus->cpu = -1;
+        if (cpus > 0)
+        {
+            cpu_set_t set;
+            
+            CPU_ZERO(&set);
+            CPU_SET(i % cpus, &set);
+            if (pthread_setaffinity_np(bus->thread, sizeof(cpu_set_t), &set) == 0)
+            {
+                bus->cpu = (int)(i % cpus);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler stop
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ * @note      the io threads finish their round and are joined, queued samples are kept
+ */
+uint8_t raspberrypi4b_max6675_sampler_stop(raspberrypi4b_max6675_sampler_t *sampler)
+{
+    uint8_t i;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    
+    __atomic_store_n(&sampler->running, 0, __ATOMIC_RELEASE);
+    for (i = 0; i < sampler->bus_num; i++)
+    {
+        if (sampler->bus[i].started != 0)
+        {
+            (void)pthread_join(sampler->bus[i].thread, NULL);
+            sampler->bus[i].started = 0;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler pop a sample
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 queue is empty
+ *             - 2 sampler or sample is NULL
+ * @note       lock free and safe with the io threads running
+ */
+uint8_t raspberrypi4b_max6675_sampler_pop(raspberrypi4b_max6675_sampler_t *sampler, raspberrypi4b_max6675_sample_t *sample)
+{
+    raspberrypi4b_max6675_sampler_cell_t *cell;
+    uint32_t pos;
+    uint32_t seq;
+    int32_t diff;
+    
+    if ((sampler == NULL) || (sample == NULL))
+    {
+        return 2;
+    }
+    
+    pos = __atomic_load_n(&sampler->tail, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        cell = &sampler->cell[pos & sampler->mask];
+        seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        diff = (int32_t)(seq - (pos + 1));
+        if (diff == 0)
+        {
+            /* the cell is published, claim it */
+            if (__atomic_compare_exchange_n(&sampler->tail, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return 1;
+        }
+        else
+        {
+            pos = __atomic_load_n(&sampler->tail, __ATOMIC_RELAXED);
+        }
+    }
+    *sample = cell->sample;
+    
+    /* free the cell for the next lap */
+    __atomic_store_n(&cell->seq, pos + sampler->mask + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler get the round period statistics of a controller
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index io thread index
+ * @param[out] *stats pointer to a periodic statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ *             - 2 sampler or stats is NULL
+ * @note       only a sampler started with a period records the statistics
+ */
+uint8_t raspberrypi4b_max6675_sampler_get_period_stats(raspberrypi4b_max6675_sampler_t *sampler, uint8_t index, periodic_stats_t *stats)
+{
+    if ((sampler == NULL) || (stats == NULL))
+    {
+        return 2;
+    }
+    if (index >= sampler->bus_num)
+    {
+        return 1;
+    }
+    
+    return periodic_get_stats(&sampler->bus[index].periodic, stats);
+}
+
+/**
+ * @brief      sampler get the dropped sample number
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sampler or dropped is NULL
+ * @note       an io thread drops the sample instead of waiting when the queue is full
+ */
+uint8_t raspberrypi4b_max6675_sampler_get_dropped(raspberrypi4b_max6675_sampler_t *sampler, uint32_t *dropped)
+{
+    if ((sampler == NULL) || (dropped == NULL))
+    {
+        return 2;
+    }
+    
+    *dropped = __atomic_load_n(&sampler->dropped, __ATOMIC_RELAXED);
+    
+    return 0;
+}
@@ -0,0 +1,727 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_server.c
+ * @brief     raspberrypi4b driver max6675 server source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "raspberrypi4b_driver_max6675_server.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief server definition
+ */
+#define SERVER_LISTEN_ID        RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS        /**< epoll id of the listening socket */
+#define SERVER_WATCH_ID         (RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS + 1)  /**< epoll id of the watched handle */
+#define SERVER_MAX_EVENTS       16                                              /**< events handled per wait */
+
+/**
+ * @brief     put a little endian uint32
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static inline void a_server_put_u32(uint8_t *buf, uint32_t v)
+{
+    buf[0] = (uint8_t)(v);
+    buf[1] = (uint8_t)(v >> 8);
+    buf[2] = (uint8_t)(v >> 16);
+    buf[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief     add data to a client queue
+ * @param[in] *client pointer to a client structure
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      none
+ */
+static uint8_t a_server_enqueue(raspberrypi4b_max6675_server_client_t *client, const uint8_t *data, uint32_t len)
+{
+    uint32_t off;
+    uint32_t first;
+    
+    if ((client->head - client->tail + len) > RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE)
+    {
+        return 1;
+    }
+    
+    /* copy around the end of the queue */
+    off = client->head & (RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE - 1);
+    first = RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE - off;
+    if (first > len)
+    {
+        first = len;
+    }
+    memcpy(client->queue + off, data, first);
+    memcpy(client->queue, data + first, len - first);
+    client->head += len;
+    
+    return 0;
+}
+
+/**
+ * @brief     close a client
+ * @param[in] *server pointer to a server structure
+ * @param[in] *client pointer to a client structure
+ * @note      closing the socket removes it from the epoll set
+ */
+static void a_server_drop(raspberrypi4b_max6675_server_t *server, raspberrypi4b_max6675_server_client_t *client)
+{
+    (void)close(client->fd);
+    client->fd = -1;
+    server->clients--;
+}
+
+/**
+ * @brief     set the epoll events of a client
+ * @param[in] *server pointer to a server structure
+ * @param[in] index client index
+ * @param[in] armed 1 waits for EPOLLOUT
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+static uint8_t a_server_arm(raspberrypi4b_max6675_server_t *server, uint32_t index, uint8_t armed)
+{
+    struct epoll_event ev;
+    
+    ev.events = EPOLLIN | EPOLLRDHUP | ((armed != 0) ? EPOLLOUT : 0);
+    ev.data.u32 = index;
+    if (epoll_ctl(server->epfd, EPOLL_CTL_MOD, server->client[index].fd, &ev) != 0)
+    {
+        return 1;
+    }
+    server->client[index].armed = armed;
+    
+    return 0;
+}
+
+/**
+ * @brief     send the queue of a client
+ * @param[in] *server pointer to a server structure
+ * @param[in] index client index
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      the queue goes in one gathered write of its two halves, a full socket buffer arms
+ *            EPOLLOUT instead of waiting
+ */
+static uint8_t a_server_send(raspberrypi4b_max6675_server_t *server, uint32_t index)
+{
+    raspberrypi4b_max6675_server_client_t *client = &server->client[index];
+    struct iovec iov[2];
+    struct msghdr msg;
+    uint32_t pending;
+    uint32_t off;
+    ssize_t n;
+    
+    while (client->head != client->tail)
+    {
+        pending = client->head - client->tail;
+        off = client->tail & (RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE - 1);
+        iov[0].iov_base = client->queue + off;
+        iov[0].iov_len = RASPBERRYPI4B_MAX6675_SERVER_QUEUE_SIZE - off;
+        if (iov[0].iov_len > pending)
+        {
+            iov[0].iov_len = pending;
+        }
+        iov[1].iov_base = client->queue;
+        iov[1].iov_len = pending - iov[0].iov_len;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (iov[1].iov_len != 0) ? 2 : 1;
+        
+        /* sendmsg is writev for sockets and does not raise SIGPIPE */
+        n = sendmsg(client->fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                return (client->armed != 0) ? 0 : a_server_arm(server, index, 1);
+            }
+            
+            return 1;
+        }
+        client->tail += (uint32_t)n;
+        client->run = 0;
+        server->sent += (uint64_t)n;
+        server->writes++;
+    }
+    
+    /* drained */
+    if (client->armed != 0)
+    {
+        return a_server_arm(server, index, 0);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     read the requests of a client
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 client hung up
+ * @note      a line with a number sets the decimation, other lines are ignored
+ */
+static uint8_t a_server_receive(raspberrypi4b_max6675_server_client_t *client)
+{
+    char buf[64];
+    ssize_t n;
+    ssize_t i;
+    
+    while (1)
+    {
+        n = read(client->fd, buf, sizeof(buf));
+        if (n == 0)
+        {
+            return 1;
+        }
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : 1;
+        }
+        for (i = 0; i < n; i++)
+        {
+            if (buf[i] == '\n')
+            {
+                unsigned long d;
+                char *end;
+                
+                client->line[client->line_len] = '\0';
+                d = strtoul(client->line, &end, 10);
+                if ((end != client->line) && (d != 0) && (d <= RASPBERRYPI4B_MAX6675_SERVER_MAX_DECIMATION))
+                {
+                    client->decimation = (uint32_t)d;
+                }
+                client->line_len = 0;
+            }
+            else if (client->line_len < (sizeof(client->line) - 1))
+            {
+                client->line[client->line_len++] = buf[i];
+            }
+            else
+            {
+                /* too long, the line is ignored */
+            }
+        }
+    }
+}
+
+/**
+ * @brief     accept the waiting clients
+ * @param[in] *server pointer to a server structure
+ * @note      a client over RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS is closed at once
+ */
+static void a_server_accept(raspberrypi4b_max6675_server_t *server)
+{
+    uint8_t header[RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE];
+    raspberrypi4b_max6675_server_client_t *client;
+    struct epoll_event ev;
+    uint32_t i;
+    int fd;
+    
+    memcpy(header, RASPBERRYPI4B_MAX6675_TRACE_MAGIC, 8);
+    a_server_put_u32(header + 8, RASPBERRYPI4B_MAX6675_TRACE_VERSION);
+    a_server_put_u32(header + 12, RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE);
+    while (1)
+    {
+        fd = accept4(server->fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        
+        /* find a free slot */
+        for (i = 0; i < RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS; i++)
+        {
+            if (server->client[i].fd < 0)
+            {
+                break;
+            }
+        }
+        if (i == RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u32 = i;
+        if (epoll_ctl(server->epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        
+        /* the trace header goes first */
+        client = &server->client[i];
+        client->fd = fd;
+        client->armed = 0;
+        client->line_len = 0;
+        client->decimation = 1;
+        client->head = 0;
+        client->tail = 0;
+        client->dropped = 0;
+        client->run = 0;
+        (void)a_server_enqueue(client, header, RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE);
+        server->clients++;
+        server->accepted++;
+        if (a_server_send(server, i) != 0)
+        {
+            a_server_drop(server, client);
+        }
+    }
+}
+
+/**
+ * @brief     server open a socket for the subscribers
+ * @param[in] *server pointer to a server structure
+ * @param[in] *path pointer to a unix socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a stale socket file of the same path is removed
+ */
+uint8_t raspberrypi4b_max6675_server_open(raspberrypi4b_max6675_server_t *server, const char *path)
+{
+    struct sockaddr_un addr;
+    struct epoll_event ev;
+    uint32_t i;
+    
+    if ((server == NULL) || (path == NULL) || (strlen(path) >= sizeof(addr.sun_path)))
+    {
+        return 1;
+    }
+    memset(server, 0, offsetof(raspberrypi4b_max6675_server_t, client));
+    for (i = 0; i < RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS; i++)
+    {
+        server->client[i].fd = -1;
+    }
+    server->watch_fd = -1;
+    (void)snprintf(server->path, sizeof(server->path), "%s", path);
+    
+    /* listen */
+    server->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (server->fd < 0)
+    {
+        perror("max6675: socket failed");
+        
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    (void)snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    (void)unlink(path);
+    if ((bind(server->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(server->fd, SOMAXCONN) != 0))
+    {
+        perror("max6675: socket bind failed");
+        (void)close(server->fd);
+        
+        return 1;
+    }
+    
+    /* one epoll set for the listener and the clients */
+    server->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (server->epfd < 0)
+    {
+        perror("max6675: epoll failed");
+        (void)close(server->fd);
+        (void)unlink(path);
+        
+        return 1;
+    }
+    ev.events = EPOLLIN;
+    ev.data.u32 = SERVER_LISTEN_ID;
+    if (epoll_ctl(server->epfd, EPOLL_CTL_ADD, server->fd, &ev) != 0)
+    {
+        perror("max6675: epoll failed");
+        (void)close(server->epfd);
+        (void)close(server->fd);
+        (void)unlink(path);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      server handle the socket events
+ * @param[in]  *server pointer to a server structure
+ * @param[in]  timeout_ms longest wait for an event, 0 does not wait
+ * @param[out] *events pointer to a handled event number buffer, 0 means the wait timed out
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ * @note       accepts the subscribers, reads their decimation requests, sends the queued records
+ *             of the subscribers that were not writable and closes the ones that hung up
+ */
+uint8_t raspberrypi4b_max6675_server_poll(raspberrypi4b_max6675_server_t *server, int timeout_ms, uint32_t *events)
+{
+    struct epoll_event ev[SERVER_MAX_EVENTS];
+    raspberrypi4b_max6675_server_client_t *client;
+    int n;
+    int i;
+    
+    if ((server == NULL) || (events == NULL))
+    {
+        return 1;
+    }
+    
+    *events = 0;
+    n = epoll_wait(server->epfd, ev, SERVER_MAX_EVENTS, timeout_ms);
+    if (n < 0)
+    {
+        /* a signal ends the wait early */
+        return (errno == EINTR) ? 0 : 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (ev[i].data.u32 == SERVER_LISTEN_ID)
+        {
+            a_server_accept(server);
+            
+            continue;
+        }
+        if (ev[i].data.u32 == SERVER_WATCH_ID)
+        {
+            server->watch(server->watch_arg);
+            
+            continue;
+        }
+        client = &server->client[ev[i].data.u32];
+        if (client->fd < 0)
+        {
+            continue;
+        }
+        if ((ev[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+        {
+            a_server_drop(server, client);
+            
+            continue;
+        }
+        if ((ev[i].events & (EPOLLIN | EPOLLRDHUP)) != 0)
+        {
+            if (a_server_receive(client) != 0)
+            {
+                a_server_drop(server, client);
+                
+                continue;
+            }
+        }
+        if ((ev[i].events & EPOLLOUT) != 0)
+        {
+            if (a_server_send(server, ev[i].data.u32) != 0)
+            {
+                a_server_drop(server, client);
+                
+                continue;
+            }
+        }
+    }
+    *events = (uint32_t)n;
+    
+    return 0;
+}
+
+/**
+ * @brief     server watch another handle in the same event loop
+ * @param[in] *server pointer to a server structure
+ * @param[in] fd handle to watch, such as another epoll handle
+ * @param[in] *watch pointer to a function called by the poll when the handle is readable
+ * @param[in] *arg pointer to the watch argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 watch failed
+ * @note      only one handle can be watched
+ */
+uint8_t raspberrypi4b_max6675_server_watch(raspberrypi4b_max6675_server_t *server, int fd,
+                                           void (*watch)(void *arg), void *arg)
+{
+    struct epoll_event ev;
+    
+    if ((server == NULL) || (fd < 0) || (watch == NULL) || (server->watch_fd >= 0))
+    {
+        return 1;
+    }
+    
+    ev.events = EPOLLIN;
+    ev.data.u32 = SERVER_WATCH_ID;
+    if (epoll_ctl(server->epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+    {
+        return 1;
+    }
+    server->watch_fd = fd;
+    server->watch = watch;
+    server->watch_arg = arg;
+    
+    return 0;
+}
+
+/**
+ * @brief     server publish a sample
+ * @param[in] *server pointer to a server structure
+ * @param[in] tick tick in ms
+ * @param[in] frame chip register frame
+ * @param[in] id sensor id
+ * @param[in] res read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      the record is only queued, a subscriber with a full queue loses it and is closed after
+ *            RASPBERRYPI4B_MAX6675_SERVER_DROP_LIMIT lost records in a row, so it never blocks the
+ *            sampling
+ */
+uint8_t raspberrypi4b_max6675_server_publish(raspberrypi4b_max6675_server_t *server, uint32_t tick,
+                                             uint16_t frame, uint8_t id, uint8_t res)
+{
+    uint8_t rec[RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE];
+    raspberrypi4b_max6675_server_client_t *client;
+    uint32_t count;
+    uint32_t i;
+    
+    if (server == NULL)
+    {
+        return 1;
+    }
+    
+    a_server_put_u32(rec, tick);
+    rec[4] = (uint8_t)(frame);
+    rec[5] = (uint8_t)(frame >> 8);
+    rec[6] = id;
+    rec[7] = res;
+    
+    /* subscribers of the same decimation get the same samples */
+    count = server->count[id]++;
+    for (i = 0; (i < RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS) && (server->clients != 0); i++)
+    {
+        client = &server->client[i];
+        if ((client->fd < 0) || ((count % client->decimation) != 0))
+        {
+            continue;
+        }
+        if (a_server_enqueue(client, rec, RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE) != 0)
+        {
+            client->dropped++;
+            client->run++;
+            server->dropped++;
+            if (client->run >= RASPBERRYPI4B_MAX6675_SERVER_DROP_LIMIT)
+            {
+                a_server_drop(server, client);
+                server->disconnected++;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     server send the queued records
+ * @param[in] *server pointer to a server structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      every subscriber gets its whole queue in one gathered write without waiting, the rest
+ *            is sent by the poll when the socket is writable again
+ */
+uint8_t raspberrypi4b_max6675_server_flush(raspberrypi4b_max6675_server_t *server)
+{
+    raspberrypi4b_max6675_server_client_t *client;
+    uint32_t i;
+    
+    if (server == NULL)
+    {
+        return 1;
+    }
+    
+    for (i = 0; (i < RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS) && (server->clients != 0); i++)
+    {
+        client = &server->client[i];
+        if ((client->fd < 0) || (client->armed != 0))
+        {
+            continue;
+        }
+        if (a_server_send(server, i) != 0)
+        {
+            a_server_drop(server, client);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     server close
+ * @param[in] *server pointer to a server structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the subscribers are disconnected and the socket file is removed
+ */
+uint8_t raspberrypi4b_max6675_server_close(raspberrypi4b_max6675_server_t *server)
+{
+    uint8_t res = 0;
+    uint32_t i;
+    
+    if ((server == NULL) || (server->fd < 0))
+    {
+        return 1;
+    }
+    
+    for (i = 0; i < RASPBERRYPI4B_MAX6675_SERVER_MAX_CLIENTS; i++)
+    {
+        if (server->client[i].fd >= 0)
+        {
+            a_server_drop(server, &server->client[i]);
+        }
+    }
+    res |= (close(server->epfd) != 0) ? 1 : 0;
+    res |= (close(server->fd) != 0) ? 1 : 0;
+    res |= (unlink(server->path) != 0) ? 1 : 0;
+    server->fd = -1;
+    server->epfd = -1;
+    server->watch_fd = -1;
+    
+    return res;
+}
+
+/**
+ * @brief      server subscribe as a client
+ * @param[in]  *path pointer to a unix socket path
+ * @param[in]  decimation send every n-th sample
+ * @param[out] *fd pointer to a socket handle buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 subscribe failed
+ * @note       the records are read from the blocking socket after the trace header
+ */
+uint8_t raspberrypi4b_max6675_server_subscribe(const char *path, uint32_t decimation, int *fd)
+{
+    uint8_t header[RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE];
+    struct sockaddr_un addr;
+    char line[16];
+    uint32_t len;
+    ssize_t n;
+    int s;
+    
+    if ((path == NULL) || (fd == NULL) || (strlen(path) >= sizeof(addr.sun_path)) ||
+        (decimation == 0) || (decimation > RASPBERRYPI4B_MAX6675_SERVER_MAX_DECIMATION))
+    {
+        return 1;
+    }
+    
+    /* connect */
+    s = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (s < 0)
+    {
+        perror("max6675: socket failed");
+        
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    (void)snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    if (connect(s, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        perror("max6675: connect failed");
+        (void)close(s);
+        
+        return 1;
+    }
+    
+    /* ask for the decimation */
+    len = (uint32_t)snprintf(line, sizeof(line), "%u\n", decimation);
+    if (send(s, line, len, MSG_NOSIGNAL) != (ssize_t)len)
+    {
+        (void)close(s);
+        
+        return 1;
+    }
+    
+    /* check the header */
+    len = 0;
+    while (len < RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE)
+    {
+        n = read(s, header + len, RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE - len);
+        if ((n < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            (void)close(s);
+            
+            return 1;
+        }
+        len += (uint32_t)n;
+    }
+    if ((memcmp(header, RASPBERRYPI4B_MAX6675_TRACE_MAGIC, 8) != 0) ||
+        (header[12] != RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE))
+    {
+        (void)fprintf(stderr, "max6675: %s is not a max6675 server.\n", path);
+        (void)close(s);
+        
+        return 1;
+    }
+    *fd = s;
+    
+    return 0;
+}
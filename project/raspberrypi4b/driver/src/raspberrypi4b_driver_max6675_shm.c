@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_shm.c
+ * @brief     raspberrypi4b driver max6675 shared memory source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_max6675_shm.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief     shared memory create a segment to publish to
+ * @param[in] *shm pointer to a shared memory structure
+ * @param[in] *name pointer to a segment name starting with a slash
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      an old segment of the same name is reused, so the readers stay attached while the
+ *            publisher restarts
+ */
+uint8_t raspberrypi4b_max6675_shm_create(raspberrypi4b_max6675_shm_t *shm, const char *name, uint32_t num)
+{
+    void *map;
+    
+    if ((shm == NULL) || (name == NULL) || (num == 0) || (num > RASPBERRYPI4B_MAX6675_SHM_MAX_SENSORS))
+    {
+        return 1;
+    }
+    memset(shm, 0, sizeof(raspberrypi4b_max6675_shm_t));
+    (void)snprintf(shm->name, sizeof(shm->name), "%s", name);
+    
+    shm->fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (shm->fd < 0)
+    {
+        perror("max6675: shm open failed");
+        
+        return 1;
+    }
+    if (ftruncate(shm->fd, sizeof(raspberrypi4b_max6675_shm_segment_t)) != 0)
+    {
+        perror("max6675: shm truncate failed");
+        (void)close(shm->fd);
+        
+        return 1;
+    }
+    map = mmap(NULL, sizeof(raspberrypi4b_max6675_shm_segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("max6675: shm mmap failed");
+        (void)close(shm->fd);
+        
+        return 1;
+    }
+    shm->seg = (raspberrypi4b_max6675_shm_segment_t *)map;
+    shm->publisher = 1;
+    
+    /* a segment of another layout is cleared, the slots of a restarted publisher are kept */
+    if ((shm->seg->magic != RASPBERRYPI4B_MAX6675_SHM_MAGIC) ||
+        (shm->seg->version != RASPBERRYPI4B_MAX6675_SHM_VERSION))
+    {
+        memset(shm->seg, 0, sizeof(raspberrypi4b_max6675_shm_segment_t));
+        shm->seg->version = RASPBERRYPI4B_MAX6675_SHM_VERSION;
+        __atomic_store_n(&shm->seg->magic, RASPBERRYPI4B_MAX6675_SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+    shm->seg->num = num;
+    shm->seg->pid = (int32_t)getpid();
+    
+    return 0;
+}
+
+/**
+ * @brief     shared memory publish a sample
+ * @param[in] *shm pointer to a shared memory structure
+ * @param[in] index sensor index
+ * @param[in] tick tick in ms
+ * @param[in] raw raw temperature in 0.25C
+ * @param[in] status read status code
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      only one thread may publish to a segment, it never waits for the readers
+ */
+uint8_t raspberrypi4b_max6675_shm_publish(raspberrypi4b_max6675_shm_t *shm, uint32_t index, uint32_t tick,
+                                          uint16_t raw, uint8_t status)
+{
+    raspberrypi4b_max6675_shm_slot_t *slot;
+    raspberrypi4b_max6675_shm_sample_t *next;
+    uint32_t count;
+    uint32_t gen;
+    
+    if ((shm == NULL) || (shm->seg == NULL) || (shm->publisher == 0) || (index >= shm->seg->num))
+    {
+        return 1;
+    }
+    
+    /* the readers of the newest copy are not disturbed */
+    slot = &shm->seg->slot[index];
+    gen = __atomic_load_n(&slot->gen, __ATOMIC_RELAXED);
+    count = slot->copy[gen % RASPBERRYPI4B_MAX6675_SHM_COPIES].count;
+    next = &slot->copy[(gen + 1) % RASPBERRYPI4B_MAX6675_SHM_COPIES];
+    
+    /* a reader that sees a store below also sees the generation published before */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&next->count, count + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&next->tick, tick, __ATOMIC_RELAXED);
+    __atomic_store_n(&next->raw, raw, __ATOMIC_RELAXED);
+    __atomic_store_n(&next->status, status, __ATOMIC_RELAXED);
+    __atomic_store_n(&next->temp, (int32_t)raw * 25, __ATOMIC_RELAXED);
+    
+    /* the next generation publishes the copy */
+    __atomic_store_n(&slot->gen, gen + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     shared memory open a published segment
+ * @param[in] *shm pointer to a shared memory structure
+ * @param[in] *name pointer to a segment name starting with a slash
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the segment is mapped read only
+ */
+uint8_t raspberrypi4b_max6675_shm_open(raspberrypi4b_max6675_shm_t *shm, const char *name)
+{
+    struct stat st;
+    void *map;
+    
+    if ((shm == NULL) || (name == NULL))
+    {
+        return 1;
+    }
+    memset(shm, 0, sizeof(raspberrypi4b_max6675_shm_t));
+    (void)snprintf(shm->name, sizeof(shm->name), "%s", name);
+    
+    shm->fd = shm_open(name, O_RDONLY, 0);
+    if (shm->fd < 0)
+    {
+        perror("max6675: shm open failed");
+        
+        return 1;
+    }
+    if ((fstat(shm->fd, &st) != 0) || ((size_t)st.st_size < sizeof(raspberrypi4b_max6675_shm_segment_t)))
+    {
+        (void)fprintf(stderr, "max6675: %s is not published.\n", name);
+        (void)close(shm->fd);
+        
+        return 1;
+    }
+    map = mmap(NULL, sizeof(raspberrypi4b_max6675_shm_segment_t), PROT_READ, MAP_SHARED, shm->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("max6675: shm mmap failed");
+        (void)close(shm->fd);
+        
+        return 1;
+    }
+    shm->seg = (raspberrypi4b_max6675_shm_segment_t *)map;
+    
+    /* check the layout */
+    if ((__atomic_load_n(&shm->seg->magic, __ATOMIC_ACQUIRE) != RASPBERRYPI4B_MAX6675_SHM_MAGIC) ||
+        (shm->seg->version != RASPBERRYPI4B_MAX6675_SHM_VERSION))
+    {
+        (void)fprintf(stderr, "max6675: %s is not published.\n", name);
+        (void)raspberrypi4b_max6675_shm_close(shm);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      shared memory read the latest sample
+ * @param[in]  *shm pointer to a shared memory structure
+ * @param[in]  index sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 no consistent snapshot in RASPBERRYPI4B_MAX6675_SHM_RETRY attempts
+ * @note       no system call and no lock, the newest copy is never written by the publisher, so
+ *             a snapshot is only read again when the publisher overtakes the reader by
+ *             RASPBERRYPI4B_MAX6675_SHM_COPIES - 1 samples of the sensor during the copy and 4 is
+ *             only returned to a reader that is stalled again and again
+ */
+uint8_t raspberrypi4b_max6675_shm_read(const raspberrypi4b_max6675_shm_t *shm, uint32_t index,
+                                       raspberrypi4b_max6675_shm_sample_t *sample)
+{
+    const raspberrypi4b_max6675_shm_slot_t *slot;
+    const raspberrypi4b_max6675_shm_sample_t *copy;
+    uint32_t gen;
+    uint32_t i;
+    
+    if ((shm == NULL) || (shm->seg == NULL) || (sample == NULL) ||
+        (index >= __atomic_load_n(&shm->seg->num, __ATOMIC_RELAXED)))
+    {
+        return 1;
+    }
+    
+    slot = &shm->seg->slot[index];
+    for (i = 0; i < RASPBERRYPI4B_MAX6675_SHM_RETRY; i++)
+    {
+        /* copy the newest sample */
+        gen = __atomic_load_n(&slot->gen, __ATOMIC_ACQUIRE);
+        copy = &slot->copy[gen % RASPBERRYPI4B_MAX6675_SHM_COPIES];
+        sample->count = __atomic_load_n(&copy->count, __ATOMIC_RELAXED);
+        sample->tick = __atomic_load_n(&copy->tick, __ATOMIC_RELAXED);
+        sample->raw = __atomic_load_n(&copy->raw, __ATOMIC_RELAXED);
+        sample->status = __atomic_load_n(&copy->status, __ATOMIC_RELAXED);
+        sample->reserved = 0;
+        sample->temp = __atomic_load_n(&copy->temp, __ATOMIC_RELAXED);
+        
+        /* the copy is only rewritten after the publisher has moved COPIES - 1 generations on */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if ((__atomic_load_n(&slot->gen, __ATOMIC_RELAXED) - gen) < (RASPBERRYPI4B_MAX6675_SHM_COPIES - 1))
+        {
+            return 0;
+        }
+    }
+    
+    return 4;
+}
+
+/**
+ * @brief     shared memory close
+ * @param[in] *shm pointer to a shared memory structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the segment is kept for the readers, shm_unlink removes it
+ */
+uint8_t raspberrypi4b_max6675_shm_close(raspberrypi4b_max6675_shm_t *shm)
+{
+    uint8_t res = 0;
+    
+    if ((shm == NULL) || (shm->seg == NULL))
+    {
+        return 1;
+    }
+    
+    res |= (munmap(shm->seg, sizeof(raspberrypi4b_max6675_shm_segment_t)) != 0) ? 1 : 0;
+    res |= (close(shm->fd) != 0) ? 1 : 0;
+    shm->seg = NULL;
+    shm->fd = -1;
+    
+    return res;
+}
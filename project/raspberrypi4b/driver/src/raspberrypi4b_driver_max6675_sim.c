@@ -0,0 +1,380 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_sim.c
+ * @brief     raspberrypi4b driver max6675 simulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_max6675_sim.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief simulator pi definition
+ */
+#define SIM_PI        3.14159265358979f        /**< pi */
+
+/**
+ * @brief virtual clock definition
+ */
+static uint8_t gs_virtual = 0;                 /**< 1 runs on the virtual clock */
+static uint32_t gs_virtual_tick = 0;           /**< virtual tick in ms */
+
+/**
+ * @brief     simulator next random number
+ * @param[in] *sim pointer to a simulator structure
+ * @return    random number, never 0
+ * @note      xorshift32, every sensor owns its state so runs are repeatable
+ */
+static uint32_t a_sim_random(raspberrypi4b_max6675_sim_t *sim)
+{
+    uint32_t x = sim->seed;
+    
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim->seed = x;
+    
+    return x;
+}
+
+/**
+ * @brief     simulator check a per million probability
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] ppm probability per million
+ * @return    1 if the event happens, else 0
+ * @note      no random number is drawn when ppm is 0
+ */
+static uint8_t a_sim_chance(raspberrypi4b_max6675_sim_t *sim, uint32_t ppm)
+{
+    if (ppm == 0)
+    {
+        return 0;
+    }
+    
+    return ((a_sim_random(sim) % 1000000U) < ppm) ? 1 : 0;
+}
+
+/**
+ * @brief     simulator gaussian noise
+ * @param[in] *sim pointer to a simulator structure
+ * @return    noise in C
+ * @note      box muller with the standard deviation of the simulator
+ */
+static float a_sim_noise(raspberrypi4b_max6675_sim_t *sim)
+{
+    float u1;
+    float u2;
+    
+    if (sim->noise == 0.0f)
+    {
+        return 0.0f;
+    }
+    
+    u1 = (float)a_sim_random(sim) / 4294967296.0f;
+    u2 = (float)a_sim_random(sim) / 4294967296.0f;
+    
+    return sim->noise * sqrtf(-2.0f * logf(u1)) * cosf(2.0f * SIM_PI * u2);
+}
+
+/**
+ * @brief     simulator make a frame
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] tick end of the conversion in ms
+ * @return    frame
+ * @note      the temperature is clamped to the 12 bit range and rounded to 0.25C
+ */
+static uint16_t a_sim_frame(raspberrypi4b_max6675_sim_t *sim, uint32_t tick)
+{
+    float temp;
+    uint16_t code;
+    
+    temp = raspberrypi4b_max6675_sim_temperature(sim, tick) + a_sim_noise(sim);
+    if (temp < 0.0f)
+    {
+        temp = 0.0f;
+    }
+    if (temp > 1023.75f)
+    {
+        temp = 1023.75f;
+    }
+    code = (uint16_t)(temp * 4.0f + 0.5f);
+    if (code > 0xFFF)
+    {
+        code = 0xFFF;
+    }
+    
+    return (uint16_t)((code << 3) | ((sim->open != 0) ? 0x04 : 0x00));
+}
+
+/**
+ * @brief     simulator init
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] seed random seed, the same seed gives the same noise and failures
+ * @return    status code
+ *            - 0 success
+ *            - 1 sim is NULL
+ * @note      the chip is powered on now at a constant 25C without noise or failures and
+ *            a finished conversion is already waiting in the output register
+ */
+uint8_t raspberrypi4b_max6675_sim_init(raspberrypi4b_max6675_sim_t *sim, uint32_t seed)
+{
+    if (sim == NULL)
+    {
+        return 1;
+    }
+    
+    memset(sim, 0, sizeof(raspberrypi4b_max6675_sim_t));
+    sim->wave = RASPBERRYPI4B_MAX6675_SIM_WAVE_CONSTANT;
+    sim->base = 25.0f;
+    sim->period_ms = 1000;
+    
+    /* xorshift never leaves 0 */
+    sim->seed = (seed != 0) ? seed : 0x9E3779B9U;
+    sim->power_tick = raspberrypi4b_max6675_sim_get_tick_ms();
+    sim->conv_tick = sim->power_tick - RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator get the temperature of the waveform
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] tick tick in ms
+ * @return    temperature in C without noise
+ * @note      none
+ */
+float raspberrypi4b_max6675_sim_temperature(raspberrypi4b_max6675_sim_t *sim, uint32_t tick)
+{
+    uint32_t t = tick - sim->power_tick;
+    uint32_t period = (sim->period_ms != 0) ? sim->period_ms : 1;
+    
+    switch (sim->wave)
+    {
+        case RASPBERRYPI4B_MAX6675_SIM_WAVE_RAMP :
+        {
+            return sim->base + sim->amplitude * ((float)t / (float)period);
+        }
+        case RASPBERRYPI4B_MAX6675_SIM_WAVE_SINE :
+        {
+            return sim->base + sim->amplitude * sinf(2.0f * SIM_PI * (float)(t % period) / (float)period);
+        }
+        case RASPBERRYPI4B_MAX6675_SIM_WAVE_STEP :
+        {
+            return sim->base + ((((t % period) * 2) >= period) ? sim->amplitude : 0.0f);
+        }
+        default :
+        {
+            return sim->base;
+        }
+    }
+}
+
+/**
+ * @brief     simulator spi init
+ * @param[in] *ctx pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_init(void *ctx)
+{
+    return (ctx != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief     simulator spi deinit
+ * @param[in] *ctx pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_deinit(void *ctx)
+{
+    return (ctx != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief      simulator spi read
+ * @param[in]  *ctx pointer to a simulator structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       as on the chip, cs low shows the last finished conversion and aborts the running
+ *             one and cs high starts a new RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS conversion
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_max6675_sim_t *sim = (raspberrypi4b_max6675_sim_t *)ctx;
+    uint32_t now;
+    uint16_t frame;
+    
+    if ((sim == NULL) || (len != 2))
+    {
+        return 1;
+    }
+    
+    /* cs low latches the finished conversion or aborts the running one */
+    now = raspberrypi4b_max6675_sim_get_tick_ms();
+    sim->reads++;
+    if ((now - sim->conv_tick) >= RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS)
+    {
+        sim->frame = a_sim_frame(sim, sim->conv_tick + RASPBERRYPI4B_MAX6675_SIM_CONVERSION_MS);
+    }
+    else
+    {
+        sim->aborted++;
+    }
+    
+    /* cs high starts a new conversion */
+    sim->conv_tick = now;
+    
+    /* the transfer itself fails */
+    if (a_sim_chance(sim, sim->fail_ppm) != 0)
+    {
+        sim->fails++;
+        
+        return 1;
+    }
+    
+    /* the line is disturbed and the frame is all ones */
+    frame = sim->frame;
+    if (a_sim_chance(sim, sim->corrupt_ppm) != 0)
+    {
+        sim->corrupts++;
+        frame = 0xFFFF;
+    }
+    buf[0] = (uint8_t)(frame >> 8);
+    buf[1] = (uint8_t)(frame & 0xFF);
+    
+    return 0;
+}
+
+/**
+ * @brief      simulator spi read many
+ * @param[in]  *ctx pointer to a simulator list
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       frame i is read from the i-th simulator of the list
+ */
+uint8_t raspberrypi4b_max6675_sim_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    raspberrypi4b_max6675_sim_t *sim = (raspberrypi4b_max6675_sim_t *)ctx;
+    uint8_t res = 0;
+    uint16_t i;
+    
+    if (sim == NULL)
+    {
+        return 1;
+    }
+    
+    for (i = 0; i < num; i++)
+    {
+        res |= raspberrypi4b_max6675_sim_spi_read_cmd(&sim[i], buf + (uint32_t)i * len, len);
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     simulator enable or disable the virtual clock
+ * @param[in] enable 1 runs on the virtual clock, 0 runs on the monotonic clock
+ * @note      the virtual clock only moves with the delay and wait functions, so thousands of
+ *            sensors can be simulated faster than real time
+ */
+void raspberrypi4b_max6675_sim_set_virtual_clock(uint8_t enable)
+{
+    __atomic_store_n(&gs_virtual_tick, raspberrypi4b_max6675_sim_get_tick_ms(), __ATOMIC_RELAXED);
+    __atomic_store_n(&gs_virtual, enable, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief  simulator get tick ms
+ * @return tick in ms
+ * @note   none
+ */
+uint32_t raspberrypi4b_max6675_sim_get_tick_ms(void)
+{
+    struct timespec t;
+    
+    if (__atomic_load_n(&gs_virtual, __ATOMIC_ACQUIRE) != 0)
+    {
+        return __atomic_load_n(&gs_virtual_tick, __ATOMIC_RELAXED);
+    }
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint32_t)((uint64_t)t.tv_sec * 1000 + (uint64_t)t.tv_nsec / 1000000);
+}
+
+/**
+ * @brief     simulator delay ms
+ * @param[in] ms time
+ * @note      the virtual clock moves forward at once
+ */
+void raspberrypi4b_max6675_sim_delay_ms(uint32_t ms)
+{
+    if (__atomic_load_n(&gs_virtual, __ATOMIC_ACQUIRE) != 0)
+    {
+        (void)__atomic_add_fetch(&gs_virtual_tick, ms, __ATOMIC_RELAXED);
+        
+        return;
+    }
+    
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     simulator wait until a tick
+ * @param[in] tick absolute tick
+ * @note      the virtual clock moves forward to the tick at once
+ */
+void raspberrypi4b_max6675_sim_wait_until_ms(uint32_t tick)
+{
+    int32_t left;
+    
+    left = (int32_t)(tick - raspberrypi4b_max6675_sim_get_tick_ms());
+    if (left > 0)
+    {
+        raspberrypi4b_max6675_sim_delay_ms((uint32_t)left);
+    }
+}
@@ -0,0 +1,549 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_max6675_trace.c
+ * @brief     raspberrypi4b driver max6675 trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_max6675_trace.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief     get a little endian uint32
+ * @param[in] *p pointer to the bytes
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_trace_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief      put a little endian uint32
+ * @param[out] *p pointer to the bytes
+ * @param[in]  v value
+ * @note       none
+ */
+static void a_trace_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief     replay open a trace
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *path pointer to a trace file path
+ * @param[in] speed playback speed, 1.0 is real time, 2.0 is twice as fast and 0.0 is as fast as possible
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the trace is memory mapped and read in place, so the playback never allocates
+ */
+uint8_t raspberrypi4b_max6675_replay_open(raspberrypi4b_max6675_replay_t *replay, const char *path, float speed)
+{
+    struct stat st;
+    void *map;
+    
+    if ((replay == NULL) || (path == NULL) || (speed < 0.0f))
+    {
+        return 1;
+    }
+    memset(replay, 0, sizeof(raspberrypi4b_max6675_replay_t));
+    replay->fd = open(path, O_RDONLY);
+    if (replay->fd < 0)
+    {
+        perror("max6675: replay open failed");
+        
+        return 1;
+    }
+    if ((fstat(replay->fd, &st) != 0) || (st.st_size < RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE))
+    {
+        (void)fprintf(stderr, "max6675: %s is not a trace.\n", path);
+        (void)close(replay->fd);
+        
+        return 1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, replay->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("max6675: replay mmap failed");
+        (void)close(replay->fd);
+        
+        return 1;
+    }
+    replay->map = (const uint8_t *)map;
+    replay->size = (size_t)st.st_size;
+    
+    /* the records are read once from the front to the back */
+    (void)madvise(map, replay->size, MADV_SEQUENTIAL);
+    
+    /* check the header */
+    if ((memcmp(replay->map, RASPBERRYPI4B_MAX6675_TRACE_MAGIC, 8) != 0) ||
+        (a_trace_get_u32(replay->map + 8) != RASPBERRYPI4B_MAX6675_TRACE_VERSION) ||
+        (a_trace_get_u32(replay->map + 12) != RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE))
+    {
+        (void)fprintf(stderr, "max6675: %s is not a trace.\n", path);
+        (void)raspberrypi4b_max6675_replay_close(replay);
+        
+        return 1;
+    }
+    replay->count = (uint32_t)((replay->size - RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE) /
+                               RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE);
+    replay->speed = speed;
+    (void)periodic_init(&replay->pace, 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     replay close the trace
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t raspberrypi4b_max6675_replay_close(raspberrypi4b_max6675_replay_t *replay)
+{
+    uint8_t res = 0;
+    
+    if (replay == NULL)
+    {
+        return 1;
+    }
+    if (replay->map != NULL)
+    {
+        res |= (munmap((void *)replay->map, replay->size) != 0) ? 1 : 0;
+        replay->map = NULL;
+    }
+    if (replay->fd >= 0)
+    {
+        res |= (close(replay->fd) != 0) ? 1 : 0;
+        replay->fd = -1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     replay check the end of the trace
+ * @param[in] *replay pointer to a replay structure
+ * @return    1 if every record has been played, else 0
+ * @note      a looping replay never ends
+ */
+uint8_t raspberrypi4b_max6675_replay_end(raspberrypi4b_max6675_replay_t *replay)
+{
+    return ((replay->loop == 0) && (replay->index >= replay->count)) ? 1 : 0;
+}
+
+/**
+ * @brief      replay spi read
+ * @param[in]  *ctx pointer to a replay structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       every read plays the next record, it waits until the record is due at the playback
+ *             speed and returns the recorded frame and spi result, the end of the trace fails
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_max6675_replay_t *replay = (raspberrypi4b_max6675_replay_t *)ctx;
+    const uint8_t *rec;
+    uint32_t tick;
+    
+    if ((replay == NULL) || (replay->map == NULL) || (len != 2) || (replay->count == 0))
+    {
+        return 1;
+    }
+    if (replay->index >= replay->count)
+    {
+        if (replay->loop == 0)
+        {
+            return 1;
+        }
+        replay->index = 0;
+    }
+    rec = replay->map + RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE +
+          (size_t)replay->index * RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE;
+    tick = a_trace_get_u32(rec);
+    
+    /* the first record of every pass starts the clock */
+    if (replay->index == 0)
+    {
+        replay->start_ns = periodic_now_ns();
+        replay->start_tick = tick;
+    }
+    replay->index++;
+    
+    /* wait until the record is due */
+    if (replay->speed > 0.0f)
+    {
+        (void)periodic_wait_until(&replay->pace, replay->start_ns +
+                                  (uint64_t)((double)(tick - replay->start_tick) * 1000000.0 / replay->speed));
+    }
+    
+    /* the frame is stored little endian and read out big endian as on the bus */
+    buf[0] = rec[5];
+    buf[1] = rec[4];
+    
+    return (rec[7] != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     replay spi init
+ * @param[in] *ctx pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the trace must be opened before
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_init(void *ctx)
+{
+    raspberrypi4b_max6675_replay_t *replay = (raspberrypi4b_max6675_replay_t *)ctx;
+    
+    return ((replay != NULL) && (replay->map != NULL)) ? 0 : 1;
+}
+
+/**
+ * @brief     replay spi deinit
+ * @param[in] *ctx pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the trace stays open
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_deinit(void *ctx)
+{
+    return (ctx != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief      replay spi read many
+ * @param[in]  *ctx pointer to a replay structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the next num records are played
+ */
+uint8_t raspberrypi4b_max6675_replay_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    uint8_t res = 0;
+    uint16_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        res |= raspberrypi4b_max6675_replay_spi_read_cmd(ctx, buf + (uint32_t)i * len, len);
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     capture open a trace
+ * @param[in] *capture pointer to a capture structure
+ * @param[in] *path pointer to a trace file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the file is created or truncated
+ */
+uint8_t raspberrypi4b_max6675_capture_open(raspberrypi4b_max6675_capture_t *capture, const char *path)
+{
+    int fd;
+    
+    if ((capture == NULL) || (path == NULL))
+    {
+        return 1;
+    }
+    
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        perror("max6675: capture open failed");
+        
+        return 1;
+    }
+    
+    return raspberrypi4b_max6675_capture_open_fd(capture, fd);
+}
+
+/**
+ * @brief     capture open a trace on a file handle
+ * @param[in] *capture pointer to a capture structure
+ * @param[in] fd opened file, pipe or socket handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the capture owns the handle and closes it
+ */
+uint8_t raspberrypi4b_max6675_capture_open_fd(raspberrypi4b_max6675_capture_t *capture, int fd)
+{
+    if ((capture == NULL) || (fd < 0))
+    {
+        return 1;
+    }
+    
+    capture->fd = fd;
+    capture->frames = 0;
+    
+    /* the header goes first */
+    memcpy(capture->buf, RASPBERRYPI4B_MAX6675_TRACE_MAGIC, 8);
+    a_trace_put_u32(capture->buf + 8, RASPBERRYPI4B_MAX6675_TRACE_VERSION);
+    a_trace_put_u32(capture->buf + 12, RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE);
+    capture->len = RASPBERRYPI4B_MAX6675_TRACE_HEADER_SIZE;
+    
+    return 0;
+}
+
+/**
+ * @brief     capture write a record
+ * @param[in] *capture pointer to a capture structure
+ * @param[in] tick tick in ms
+ * @param[in] frame chip register frame
+ * @param[in] id sensor id
+ * @param[in] res spi result
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the records are buffered and written when the buffer is full
+ */
+uint8_t raspberrypi4b_max6675_capture_write(raspberrypi4b_max6675_capture_t *capture, uint32_t tick,
+                                            uint16_t frame, uint8_t id, uint8_t res)
+{
+    uint8_t *rec;
+    
+    if ((capture == NULL) || (capture->fd < 0))
+    {
+        return 1;
+    }
+    if ((capture->len + RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE) > RASPBERRYPI4B_MAX6675_TRACE_BUFFER_SIZE)
+    {
+        if (raspberrypi4b_max6675_capture_flush(capture) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    rec = capture->buf + capture->len;
+    a_trace_put_u32(rec, tick);
+    rec[4] = (uint8_t)(frame);
+    rec[5] = (uint8_t)(frame >> 8);
+    rec[6] = id;
+    rec[7] = res;
+    capture->len += RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE;
+    capture->frames++;
+    
+    return 0;
+}
+
+/**
+ * @brief     capture write all buffered bytes
+ * @param[in] *capture pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the records are kept until the buffer is full without it
+ */
+uint8_t raspberrypi4b_max6675_capture_flush(raspberrypi4b_max6675_capture_t *capture)
+{
+    uint32_t off = 0;
+    ssize_t n;
+    
+    if ((capture == NULL) || (capture->fd < 0))
+    {
+        return 1;
+    }
+    
+    while (off < capture->len)
+    {
+        n = write(capture->fd, capture->buf + off, capture->len - off);
+        if (n < 0)
+        {
+            perror("max6675: capture write failed");
+            
+            return 1;
+        }
+        off += (uint32_t)n;
+    }
+    capture->len = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     capture close the trace
+ * @param[in] *capture pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the buffered records are written first
+ */
+uint8_t raspberrypi4b_max6675_capture_close(raspberrypi4b_max6675_capture_t *capture)
+{
+    uint8_t res;
+    
+    if ((capture == NULL) || (capture->fd < 0))
+    {
+        return 1;
+    }
+    
+    res = raspberrypi4b_max6675_capture_flush(capture);
+    if (close(capture->fd) != 0)
+    {
+        res = 1;
+    }
+    capture->fd = -1;
+    
+    return res;
+}
+
+/**
+ * @brief     capture spi init
+ * @param[in] *ctx pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      the captured bus is inited
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_init(void *ctx)
+{
+    raspberrypi4b_max6675_capture_t *capture = (raspberrypi4b_max6675_capture_t *)ctx;
+    
+    if ((capture == NULL) || (capture->spi_init == NULL) || (capture->spi_deinit == NULL) ||
+        (capture->spi_read_cmd == NULL) || (capture->get_tick_ms == NULL))
+    {
+        return 1;
+    }
+    
+    return capture->spi_init(capture->ctx);
+}
+
+/**
+ * @brief     capture spi deinit
+ * @param[in] *ctx pointer to a capture structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      the captured bus is deinited, the trace stays open
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_deinit(void *ctx)
+{
+    raspberrypi4b_max6675_capture_t *capture = (raspberrypi4b_max6675_capture_t *)ctx;
+    
+    if ((capture == NULL) || (capture->spi_deinit == NULL))
+    {
+        return 1;
+    }
+    
+    return capture->spi_deinit(capture->ctx);
+}
+
+/**
+ * @brief      capture spi read
+ * @param[in]  *ctx pointer to a capture structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the captured bus is read and a frame is recorded as sensor 0
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_max6675_capture_t *capture = (raspberrypi4b_max6675_capture_t *)ctx;
+    uint8_t res;
+    
+    if ((capture == NULL) || (capture->spi_read_cmd == NULL))
+    {
+        return 1;
+    }
+    
+    res = capture->spi_read_cmd(capture->ctx, buf, len);
+    if (len == 2)
+    {
+        (void)raspberrypi4b_max6675_capture_write(capture, capture->get_tick_ms(),
+                                                  (uint16_t)((buf[0] << 8) | buf[1]), 0, res);
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      capture spi read many
+ * @param[in]  *ctx pointer to a capture structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of one frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the captured bus is read and frame i is recorded as sensor i with one tick
+ */
+uint8_t raspberrypi4b_max6675_capture_spi_read_many_cmd(void *ctx, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    raspberrypi4b_max6675_capture_t *capture = (raspberrypi4b_max6675_capture_t *)ctx;
+    uint32_t tick;
+    uint16_t i;
+    uint8_t res;
+    
+    if ((capture == NULL) || (capture->spi_read_many_cmd == NULL))
+    {
+        return 1;
+    }
+    
+    res = capture->spi_read_many_cmd(capture->ctx, buf, len, num);
+    if (len == 2)
+    {
+        tick = capture->get_tick_ms();
+        for (i = 0; i < num; i++)
+        {
+            (void)raspberrypi4b_max6675_capture_write(capture, tick, (uint16_t)((buf[i * 2] << 8) | buf[i * 2 + 1]),
+                                                      (uint8_t)i, res);
+        }
+    }
+    
+    return res;
+}
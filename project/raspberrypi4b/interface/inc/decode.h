@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      decode.h
+ * @brief     decode header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DECODE_H
+#define DECODE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup decode decode function
+ * @brief    decode function modules
+ * @{
+ */
+
+/**
+ * @brief decode path enumeration definition
+ */
+typedef enum
+{
+    DECODE_PATH_SCALAR = 0,        /**< scalar path */
+    DECODE_PATH_SSE2   = 1,        /**< sse2 path */
+    DECODE_PATH_AVX2   = 2,        /**< avx2 path */
+} decode_path_t;
+
+/**
+ * @brief      decode a frame buffer with the best path of the running cpu
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list with num items
+ * @param[out] *temp pointer to a temp list with num items
+ * @param[out] *status pointer to a status list with num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode failed
+ * @note       buf has the byte layout of max6675 frames, status item is 0 for a valid frame, 4 when the thermocouple input is open and 6 when d15 or d1 is set
+ */
+uint8_t decode_batch(const uint8_t *buf, uint32_t num, uint16_t *raw, float *temp, uint8_t *status);
+
+/**
+ * @brief      decode a frame buffer with the chosen path
+ * @param[in]  path decode path
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list with num items
+ * @param[out] *temp pointer to a temp list with num items
+ * @param[out] *status pointer to a status list with num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode failed
+ *             - 2 path is not supported
+ * @note       none
+ */
+uint8_t decode_batch_path(decode_path_t path, const uint8_t *buf, uint32_t num,
+                          uint16_t *raw, float *temp, uint8_t *status);
+
+/**
+ * @brief     check the decode path
+ * @param[in] path decode path
+ * @return    status code
+ *            - 0 not supported
+ *            - 1 supported
+ * @note      none
+ */
+uint8_t decode_path_supported(decode_path_t path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
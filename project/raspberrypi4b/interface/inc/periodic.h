@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      periodic.h
+ * @brief     periodic header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup periodic periodic function
+ * @brief    periodic function modules
+ * @{
+ */
+
+/**
+ * @brief periodic lateness histogram definition
+ */
+#define PERIODIC_HIST_SIZE        1024        /**< 1 us buckets, the last one holds everything later */
+
+/**
+ * @brief periodic statistics structure definition
+ */
+typedef struct periodic_stats_s
+{
+    uint64_t count;         /**< wake ups */
+    uint32_t overrun;       /**< skipped periods */
+    uint64_t min_ns;        /**< min lateness */
+    uint64_t max_ns;        /**< max lateness */
+    uint64_t p99_ns;        /**< 99th percentile lateness, 1 us resolution */
+} periodic_stats_t;
+
+/**
+ * @brief periodic structure definition
+ */
+typedef struct periodic_s
+{
+    uint64_t period_ns;                       /**< period */
+    uint64_t next_ns;                         /**< next deadline */
+    uint64_t count;                           /**< wake ups */
+    uint32_t overrun;                         /**< skipped periods */
+    uint64_t min_ns;                          /**< min lateness */
+    uint64_t max_ns;                          /**< max lateness */
+    uint32_t hist[PERIODIC_HIST_SIZE];        /**< lateness histogram */
+} periodic_t;
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   the same clock is used by every deadline
+ */
+uint64_t periodic_now_ns(void);
+
+/**
+ * @brief     periodic init
+ * @param[in] *p pointer to a periodic structure
+ * @param[in] period_ns period in ns, 0 is only used with periodic_wait_until
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the first deadline is one period from now
+ */
+uint8_t periodic_init(periodic_t *p, uint64_t period_ns);
+
+/**
+ * @brief     periodic wait for the next deadline
+ * @param[in] *p pointer to a periodic structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      the deadlines advance by a whole period and never by the measured time, deadlines
+ *            that have already passed by a whole period are skipped and counted as overruns
+ */
+uint8_t periodic_wait(periodic_t *p);
+
+/**
+ * @brief     periodic wait until an absolute deadline
+ * @param[in] *p pointer to a periodic structure
+ * @param[in] deadline_ns absolute CLOCK_MONOTONIC deadline in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      the lateness of the wake up is recorded
+ */
+uint8_t periodic_wait_until(periodic_t *p, uint64_t deadline_ns);
+
+/**
+ * @brief      periodic get the statistics
+ * @param[in]  *p pointer to a periodic structure
+ * @param[out] *stats pointer to a periodic statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t periodic_get_stats(periodic_t *p, periodic_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.h
+ * @brief     rt header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RT_H
+#define RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rt rt function
+ * @brief    rt function modules
+ * @{
+ */
+
+/**
+ * @brief rt stack prefault size definition
+ */
+#define RT_STACK_PREFAULT_SIZE        (256 * 1024)        /**< stack bytes touched before sampling */
+
+/**
+ * @brief rt applied enumeration definition
+ */
+typedef enum
+{
+    RT_APPLIED_FIFO  = 0x01,        /**< SCHED_FIFO is set */
+    RT_APPLIED_MLOCK = 0x02,        /**< memory is locked */
+    RT_APPLIED_STACK = 0x04,        /**< stack is pre-faulted */
+    RT_APPLIED_CPU   = 0x08,        /**< thread is pinned */
+} rt_applied_t;
+
+/**
+ * @brief rt config structure definition
+ */
+typedef struct rt_config_s
+{
+    int priority;                /**< SCHED_FIFO priority, 0 keeps the current policy */
+    int cpu;                     /**< pinned cpu, -1 is not pinned */
+    uint8_t lock_memory;         /**< 1 locks the current and future memory */
+    uint8_t prefault_stack;      /**< 1 touches RT_STACK_PREFAULT_SIZE bytes of stack */
+} rt_config_t;
+
+/**
+ * @brief      rt setup of the calling thread
+ * @param[in]  *config pointer to a rt config structure
+ * @param[out] *applied pointer to an applied rt_applied_t mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 some settings are not applied
+ * @note       every setting is tried on its own and a failed one is reported with its reason,
+ *             so the caller can go on without privileges
+ */
+uint8_t rt_setup(const rt_config_t *config, uint8_t *applied);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -38,6 +38,7 @@
 #define SPI_H
 
 #include <linux/spi/spi.h>
+#include <linux/spi/spidev.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -54,6 +55,11 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief spi prepared max transfers definition
+ */
+#define SPI_PREPARED_MAX_TRANSFERS        2        /**< max transfers in one prepared transaction */
+
 /**
  * @brief spi mode type enumeration definition
  */
@@ -65,6 +71,18 @@ typedef enum
     SPI_MODE_TYPE_3 = SPI_MODE_3,        /**< mode 3 */
 } spi_mode_type_t;
 
+/**
+ * @brief spi prepared transaction structure definition
+ */
+typedef struct spi_prepared_s
+{
+    int fd;                                                         /**< spi handle */
+    uint32_t freq;                                                  /**< spi running frequence, 0 is the device default */
+    uint32_t num;                                                   /**< transfer number */
+    uint32_t len;                                                   /**< total length */
+    struct spi_ioc_transfer k[SPI_PREPARED_MAX_TRANSFERS];          /**< transfer list */
+} spi_prepared_t;
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -88,6 +106,55 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq);
  */
 uint8_t spi_deinit(int fd);
 
+/**
+ * @brief     spi prepared transaction init
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @param[in] fd spi handle
+ * @param[in] freq spi running frequence, 0 is the device default
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the spi mode is set by spi_init
+ */
+uint8_t spi_prepared_init(spi_prepared_t *p, int fd, uint32_t freq);
+
+/**
+ * @brief     spi prepared transaction add a transfer
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @param[in] *tx pointer to a tx buffer, NULL sends zeros
+ * @param[in] *rx pointer to a rx buffer, NULL drops the received data
+ * @param[in] len length of the data buffer
+ * @param[in] cs_change 1 releases cs after this transfer
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+uint8_t spi_prepared_add(spi_prepared_t *p, uint8_t *tx, uint8_t *rx, uint32_t len, uint8_t cs_change);
+
+/**
+ * @brief     spi prepared transaction set the buffers of a transfer
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @param[in] index transfer index
+ * @param[in] *tx pointer to a tx buffer, NULL sends zeros
+ * @param[in] *rx pointer to a rx buffer, NULL drops the received data
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the length and the other settings are kept
+ */
+uint8_t spi_prepared_set_buffer(spi_prepared_t *p, uint32_t index, uint8_t *tx, uint8_t *rx);
+
+/**
+ * @brief     spi prepared transaction run
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      all transfers are sent in one ioctl and the transaction can be run again
+ */
+uint8_t spi_prepared_run(spi_prepared_t *p);
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      spi_fanout.h
+ * @brief     spi fanout header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SPI_FANOUT_H
+#define SPI_FANOUT_H
+
+#include "spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup spi_fanout spi fanout function
+ * @brief    spi fanout function modules
+ * @{
+ */
+
+/**
+ * @brief spi fanout libgpiod backend definition
+ */
+#ifndef SPI_FANOUT_GPIOD
+    #define SPI_FANOUT_GPIOD        0        /**< 1 builds the libgpiod cs backend */
+#endif
+
+/**
+ * @brief spi fanout max lines definition
+ */
+#define SPI_FANOUT_MAX_LINES        64        /**< max cs lines on one bus */
+
+/**
+ * @brief spi fanout simulator structure definition
+ */
+typedef struct spi_fanout_sim_s
+{
+    uint16_t frame[SPI_FANOUT_MAX_LINES];        /**< frame returned by every line */
+    uint32_t sets;                               /**< bulk set calls */
+    uint32_t transfers;                          /**< spi transfers */
+    uint32_t errors;                             /**< transfers without exactly one selected line */
+} spi_fanout_sim_t;
+
+/**
+ * @brief spi fanout structure definition
+ */
+typedef struct spi_fanout_s
+{
+    char *name;                                                                   /**< spi device name */
+    int fd;                                                                       /**< spi handle opened with SPI_NO_CS */
+    spi_prepared_t read;                                                          /**< prepared frame read */
+    uint16_t num;                                                                 /**< cs line number */
+    int values[SPI_FANOUT_MAX_LINES];                                             /**< cs line levels, 0 selects */
+    int32_t selected;                                                             /**< selected line, -1 is none */
+    uint8_t (*cs_set)(struct spi_fanout_s *fanout);                               /**< set all cs lines in one call */
+    uint8_t (*transfer)(struct spi_fanout_s *fanout, uint8_t *buf, uint16_t len); /**< read from the selected line */
+    void (*release)(struct spi_fanout_s *fanout);                                 /**< release the backend */
+    void *gpio;                                                                   /**< gpio backend state */
+    spi_fanout_sim_t *sim;                                                        /**< simulator, NULL on hardware */
+} spi_fanout_t;
+
+/**
+ * @brief     spi fanout init with libgpiod cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @param[in] *name pointer to a spi device name buffer
+ * @param[in] freq spi running frequence
+ * @param[in] *chip pointer to a gpio chip name buffer
+ * @param[in] *offsets pointer to a cs line offset list
+ * @param[in] num cs line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      spidev runs with SPI_NO_CS and all cs lines are requested as one bulk output,
+ *            active low and deselected
+ */
+uint8_t spi_fanout_init(spi_fanout_t *fanout, char *name, uint32_t freq,
+                        char *chip, const unsigned int *offsets, uint16_t num);
+
+/**
+ * @brief     spi fanout init with simulated cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @param[in] *sim pointer to a spi fanout simulator structure
+ * @param[in] *name pointer to a spi device name buffer
+ * @param[in] num cs line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      no spi or gpio device is opened, every transfer returns the frame of the selected
+ *            line and checks that exactly one line is selected
+ */
+uint8_t spi_fanout_sim_init(spi_fanout_t *fanout, spi_fanout_sim_t *sim, char *name, uint16_t num);
+
+/**
+ * @brief     spi fanout deinit
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t spi_fanout_deinit(spi_fanout_t *fanout);
+
+/**
+ * @brief      spi fanout read one line
+ * @param[in]  *fanout pointer to a spi fanout structure
+ * @param[in]  line cs line
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       two bulk sets, one selects the line and one releases it
+ */
+uint8_t spi_fanout_read(spi_fanout_t *fanout, uint16_t line, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      spi fanout read many lines
+ * @param[in]  *fanout pointer to a spi fanout structure
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len length of one frame
+ * @param[in]  num line number, lines 0 to num - 1 are read
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the release of a line and the select of the next one share one bulk set,
+ *             so num lines cost num + 1 gpio calls instead of 2 * num
+ */
+uint8_t spi_fanout_read_many(spi_fanout_t *fanout, uint8_t *buf, uint16_t len, uint16_t num);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
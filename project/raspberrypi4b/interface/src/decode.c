@@ -0,0 +1,301 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      decode.c
+ * @brief     decode source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "decode.h"
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DECODE_X86        /**< x86 paths */
+#endif
+
+/**
+ * @brief      decode frames with the scalar path
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list
+ * @param[out] *temp pointer to a temp list
+ * @param[out] *status pointer to a status list
+ * @note       none
+ */
+static void a_decode_scalar(const uint8_t *buf, uint32_t num, uint16_t *raw, float *temp, uint8_t *status)
+{
+    uint32_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        uint16_t data;
+        
+        /* get the frame */
+        data = (uint16_t)(((uint16_t)buf[i * 2] << 8) | buf[i * 2 + 1]);
+        
+        /* decode the frame, d15 is a dummy bit */
+        raw[i] = (data >> 3) & 0x0FFF;
+        temp[i] = (float)raw[i] * 0.25f;
+        if ((data & 0x8002) != 0)
+        {
+            status[i] = 6;
+        }
+        else
+        {
+            status[i] = (uint8_t)(data & 0x04);
+        }
+    }
+}
+
+#if defined(DECODE_X86) && defined(__SSE2__)
+/**
+ * @brief      decode frames with the sse2 path
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list
+ * @param[out] *temp pointer to a temp list
+ * @param[out] *status pointer to a status list
+ * @note       8 frames are decoded in one loop
+ */
+static void a_decode_sse2(const uint8_t *buf, uint32_t num, uint16_t *raw, float *temp, uint8_t *status)
+{
+    const __m128i mask = _mm_set1_epi16(0x0FFF);
+    const __m128i fixed = _mm_set1_epi16((short)0x8002);
+    const __m128i open = _mm_set1_epi16(0x0004);
+    const __m128i corrupt = _mm_set1_epi16(6);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(0.25f);
+    uint32_t i;
+    
+    for (i = 0; (i + 8) <= num; i += 8)
+    {
+        __m128i v;
+        __m128i r;
+        __m128i f;
+        __m128i z;
+        
+        /* load and swap the bytes of 8 frames */
+        v = _mm_loadu_si128((const __m128i *)(buf + i * 2));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        
+        /* get the 12 bits raw data and the status, z is all ones when d15 and d1 are clear */
+        r = _mm_and_si128(_mm_srli_epi16(v, 3), mask);
+        z = _mm_cmpeq_epi16(_mm_and_si128(v, fixed), zero);
+        f = _mm_or_si128(_mm_and_si128(z, _mm_and_si128(v, open)), _mm_andnot_si128(z, corrupt));
+        _mm_storeu_si128((__m128i *)(raw + i), r);
+        _mm_storel_epi64((__m128i *)(status + i), _mm_packus_epi16(f, f));
+        
+        /* convert data */
+        _mm_storeu_ps(temp + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(r, zero)), scale));
+        _mm_storeu_ps(temp + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(r, zero)), scale));
+    }
+    
+    /* decode the left frames */
+    a_decode_scalar(buf + i * 2, num - i, raw + i, temp + i, status + i);
+}
+#endif
+
+#if defined(DECODE_X86) && defined(__GNUC__)
+/**
+ * @brief      decode frames with the avx2 path
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list
+ * @param[out] *temp pointer to a temp list
+ * @param[out] *status pointer to a status list
+ * @note       16 frames are decoded in one loop
+ */
+__attribute__((target("avx2")))
+static void a_decode_avx2(const uint8_t *buf, uint32_t num, uint16_t *raw, float *temp, uint8_t *status)
+{
+    const __m256i swap = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m256i mask = _mm256_set1_epi16(0x0FFF);
+    const __m256i fixed = _mm256_set1_epi16((short)0x8002);
+    const __m256i open = _mm256_set1_epi16(0x0004);
+    const __m256i corrupt = _mm256_set1_epi16(6);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256 scale = _mm256_set1_ps(0.25f);
+    uint32_t i;
+    
+    for (i = 0; (i + 16) <= num; i += 16)
+    {
+        __m256i v;
+        __m256i r;
+        __m256i f;
+        __m256i z;
+        
+        /* load and swap the bytes of 16 frames */
+        v = _mm256_loadu_si256((const __m256i *)(buf + i * 2));
+        v = _mm256_shuffle_epi8(v, swap);
+        
+        /* get the 12 bits raw data and the status, z is all ones when d15 and d1 are clear */
+        r = _mm256_and_si256(_mm256_srli_epi16(v, 3), mask);
+        z = _mm256_cmpeq_epi16(_mm256_and_si256(v, fixed), zero);
+        f = _mm256_or_si256(_mm256_and_si256(z, _mm256_and_si256(v, open)), _mm256_andnot_si256(z, corrupt));
+        _mm256_storeu_si256((__m256i *)(raw + i), r);
+        _mm_storeu_si128((__m128i *)(status + i), _mm_packus_epi16(_mm256_castsi256_si128(f),
+                                                                    _mm256_extracti128_si256(f, 1)));
+        
+        /* convert data */
+        _mm256_storeu_ps(temp + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(r))), scale));
+        _mm256_storeu_ps(temp + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(r, 1))), scale));
+    }
+    
+    /* decode the left frames */
+    a_decode_scalar(buf + i * 2, num - i, raw + i, temp + i, status + i);
+}
+#endif
+
+/**
+ * @brief     check the decode path
+ * @param[in] path decode path
+ * @return    status code
+ *            - 0 not supported
+ *            - 1 supported
+ * @note      none
+ */
+uint8_t decode_path_supported(decode_path_t path)
+{
+    if (path == DECODE_PATH_SCALAR)
+    {
+        return 1;
+    }
+#if defined(DECODE_X86) && defined(__SSE2__)
+    else if (path == DECODE_PATH_SSE2)
+    {
+        return 1;
+    }
+#endif
+#if defined(DECODE_X86) && defined(__GNUC__)
+    else if (path == DECODE_PATH_AVX2)
+    {
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+#endif
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief      decode a frame buffer with the chosen path
+ * @param[in]  path decode path
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list with num items
+ * @param[out] *temp pointer to a temp list with num items
+ * @param[out] *status pointer to a status list with num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode failed
+ *             - 2 path is not supported
+ * @note       none
+ */
+uint8_t decode_batch_path(decode_path_t path, const uint8_t *buf, uint32_t num,
+                          uint16_t *raw, float *temp, uint8_t *status)
+{
+    /* check the buffer */
+    if ((buf == NULL) || (raw == NULL) || (temp == NULL) || (status == NULL))
+    {
+        return 1;
+    }
+    
+    /* check the path */
+    if (decode_path_supported(path) == 0)
+    {
+        return 2;
+    }
+    
+    /* run the path */
+    if (path == DECODE_PATH_SCALAR)
+    {
+        a_decode_scalar(buf, num, raw, temp, status);
+    }
+#if defined(DECODE_X86) && defined(__SSE2__)
+    else if (path == DECODE_PATH_SSE2)
+    {
+        a_decode_sse2(buf, num, raw, temp, status);
+    }
+#endif
+#if defined(DECODE_X86) && defined(__GNUC__)
+    else if (path == DECODE_PATH_AVX2)
+    {
+        a_decode_avx2(buf, num, raw, temp, status);
+    }
+#endif
+    else
+    {
+        return 2;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      decode a frame buffer with the best path of the running cpu
+ * @param[in]  *buf pointer to a big endian frame buffer
+ * @param[in]  num frame number
+ * @param[out] *raw pointer to a raw data list with num items
+ * @param[out] *temp pointer to a temp list with num items
+ * @param[out] *status pointer to a status list with num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode failed
+ * @note       buf has the byte layout of max6675 frames, status item is 0 for a valid frame, 4 when the thermocouple input is open and 6 when d15 or d1 is set
+ */
+uint8_t decode_batch(const uint8_t *buf, uint32_t num, uint16_t *raw, float *temp, uint8_t *status)
+{
+    static decode_path_t s_path = DECODE_PATH_SCALAR;
+    static uint8_t s_checked = 0;
+    
+    /* choose the path once */
+    if (s_checked == 0)
+    {
+        if (decode_path_supported(DECODE_PATH_AVX2) != 0)
+        {
+            s_path = DECODE_PATH_AVX2;
+        }
+        else if (decode_path_supported(DECODE_PATH_SSE2) != 0)
+        {
+            s_path = DECODE_PATH_SSE2;
+        }
+        else
+        {
+            s_path = DECODE_PATH_SCALAR;
+        }
+        s_checked = 1;
+    }
+    
+    return decode_batch_path(s_path, buf, num, raw, temp, status);
+}
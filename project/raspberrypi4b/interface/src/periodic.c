@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      periodic.c
+ * @brief     periodic source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "periodic.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   the same clock is used by every deadline
+ */
+uint64_t periodic_now_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     sleep until an absolute time
+ * @param[in] deadline_ns absolute CLOCK_MONOTONIC time in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 sleep failed
+ * @note      a signal does not shorten the sleep
+ */
+static uint8_t a_periodic_sleep_until(uint64_t deadline_ns)
+{
+    struct timespec t;
+    int res;
+    
+    t.tv_sec = (time_t)(deadline_ns / 1000000000ULL);
+    t.tv_nsec = (long)(deadline_ns % 1000000000ULL);
+    do
+    {
+        res = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL);
+    } while (res == EINTR);
+    if (res != 0)
+    {
+        errno = res;
+        perror("periodic: sleep failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     record the lateness of a wake up
+ * @param[in] *p pointer to a periodic structure
+ * @param[in] deadline_ns deadline in ns
+ * @note      none
+ */
+static void a_periodic_record(periodic_t *p, uint64_t deadline_ns)
+{
+    uint64_t now;
+    uint64_t late;
+    uint64_t bucket;
+    
+    now = periodic_now_ns();
+    late = (now > deadline_ns) ? (now - deadline_ns) : 0;
+    if ((p->count == 0) || (late < p->min_ns))
+    {
+        p->min_ns = late;
+    }
+    if (late > p->max_ns)
+    {
+        p->max_ns = late;
+    }
+    bucket = late / 1000;
+    if (bucket >= PERIODIC_HIST_SIZE)
+    {
+        bucket = PERIODIC_HIST_SIZE - 1;
+    }
+    p->hist[bucket]++;
+    p->count++;
+}
+
+/**
+ * @brief     periodic init
+ * @param[in] *p pointer to a periodic structure
+ * @param[in] period_ns period in ns, 0 is only used with periodic_wait_until
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the first deadline is one period from now
+ */
+uint8_t periodic_init(periodic_t *p, uint64_t period_ns)
+{
+    if (p == NULL)
+    {
+        return 1;
+    }
+    
+    memset(p, 0, sizeof(periodic_t));
+    p->period_ns = period_ns;
+    p->next_ns = periodic_now_ns() + period_ns;
+    
+    return 0;
+}
+
+/**
+ * @brief     periodic wait for the next deadline
+ * @param[in] *p pointer to a periodic structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      the deadlines advance by a whole period and never by the measured time, deadlines
+ *            that have already passed by a whole period are skipped and counted as overruns
+ */
+uint8_t periodic_wait(periodic_t *p)
+{
+    uint64_t now;
+    uint64_t missed;
+    
+    if ((p == NULL) || (p->period_ns == 0))
+    {
+        return 1;
+    }
+    
+    /* skip the missed deadlines and keep the phase */
+    now = periodic_now_ns();
+    if (now >= p->next_ns + p->period_ns)
+    {
+        missed = (now - p->next_ns) / p->period_ns;
+        p->overrun += (uint32_t)missed;
+        p->next_ns += missed * p->period_ns;
+    }
+    
+    if (periodic_wait_until(p, p->next_ns) != 0)
+    {
+        return 1;
+    }
+    p->next_ns += p->period_ns;
+    
+    return 0;
+}
+
+/**
+ * @brief     periodic wait until an absolute deadline
+ * @param[in] *p pointer to a periodic structure
+ * @param[in] deadline_ns absolute CLOCK_MONOTONIC deadline in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      the lateness of the wake up is recorded
+ */
+uint8_t periodic_wait_until(periodic_t *p, uint64_t deadline_ns)
+{
+    if (p == NULL)
+    {
+        return 1;
+    }
+    
+    if (a_periodic_sleep_until(deadline_ns) != 0)
+    {
+        return 1;
+    }
+    a_periodic_record(p, deadline_ns);
+    
+    return 0;
+}
+
+/**
+ * @brief      periodic get the statistics
+ * @param[in]  *p pointer to a periodic structure
+ * @param[out] *stats pointer to a periodic statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t periodic_get_stats(periodic_t *p, periodic_stats_t *stats)
+{
+    uint64_t rank;
+    uint64_t sum;
+    uint32_t i;
+    
+    if ((p == NULL) || (stats == NULL))
+    {
+        return 1;
+    }
+    
+    stats->count = p->count;
+    stats->overrun = p->overrun;
+    stats->min_ns = p->min_ns;
+    stats->max_ns = p->max_ns;
+    stats->p99_ns = 0;
+    
+    /* walk the histogram up to the 99th percentile */
+    rank = (p->count * 99 + 99) / 100;
+    sum = 0;
+    for (i = 0; (i < PERIODIC_HIST_SIZE) && (rank != 0); i++)
+    {
+        sum += p->hist[i];
+        if (sum >= rank)
+        {
+            stats->p99_ns = (i == PERIODIC_HIST_SIZE - 1) ? p->max_ns : (uint64_t)(i + 1) * 1000;
+            break;
+        }
+    }
+    if (stats->p99_ns > stats->max_ns)
+    {
+        stats->p99_ns = stats->max_ns;
+    }
+    
+    return 0;
+}
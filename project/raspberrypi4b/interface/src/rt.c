@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.c
+ * @brief     rt source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "rt.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief rt page size definition
+ */
+#define RT_PAGE_SIZE        4096        /**< smallest page size */
+
+/**
+ * @brief  pre-fault the stack
+ * @note   the pages stay resident once the memory is locked
+ */
+static void __attribute__((noinline)) a_rt_prefault_stack(void)
+{
+    volatile uint8_t buf[RT_STACK_PREFAULT_SIZE];
+    uint32_t i;
+    
+    for (i = 0; i < RT_STACK_PREFAULT_SIZE; i += RT_PAGE_SIZE)
+    {
+        buf[i] = 0;
+    }
+    (void)buf[0];
+}
+
+/**
+ * @brief      rt setup of the calling thread
+ * @param[in]  *config pointer to a rt config structure
+ * @param[out] *applied pointer to an applied rt_applied_t mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 some settings are not applied
+ * @note       every setting is tried on its own and a failed one is reported with its reason,
+ *             so the caller can go on without privileges
+ */
+uint8_t rt_setup(const rt_config_t *config, uint8_t *applied)
+{
+    uint8_t res;
+    uint8_t mask;
+    
+    if (config == NULL)
+    {
+        return 1;
+    }
+    
+    res = 0;
+    mask = 0;
+    
+    /* lock the memory before the stack is touched */
+    if (config->lock_memory != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("rt: mlockall failed");
+            res = 1;
+        }
+        else
+        {
+            mask |= RT_APPLIED_MLOCK;
+        }
+    }
+    
+    /* pre-fault the stack */
+    if (config->prefault_stack != 0)
+    {
+        a_rt_prefault_stack();
+        mask |= RT_APPLIED_STACK;
+    }
+    
+    /* pin the thread */
+    if (config->cpu >= 0)
+    {
+        cpu_set_t set;
+        int err;
+        
+        CPU_ZERO(&set);
+        CPU_SET(config->cpu, &set);
+        err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+        if (err != 0)
+        {
+            fprintf(stderr, "rt: pin to cpu %d failed: %s\n", config->cpu, strerror(err));
+            res = 1;
+        }
+        else
+        {
+            mask |= RT_APPLIED_CPU;
+        }
+    }
+    
+    /* set the fifo policy */
+    if (config->priority > 0)
+    {
+        struct sched_param param;
+        int err;
+        
+        param.sched_priority = config->priority;
+        err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0)
+        {
+            fprintf(stderr, "rt: SCHED_FIFO priority %d failed: %s\n", config->priority, strerror(err));
+            res = 1;
+        }
+        else
+        {
+            mask |= RT_APPLIED_FIFO;
+        }
+    }
+    
+    if (applied != NULL)
+    {
+        *applied = mask;
+    }
+    
+    return res;
+}
@@ -35,7 +35,6 @@
  */
 
 #include "spi.h"
-#include <linux/spi/spidev.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
@@ -159,6 +158,121 @@ uint8_t spi_deinit(int fd)
     }
 }
 
+/**
+ * @brief     spi prepared transaction init
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @param[in] fd spi handle
+ * @param[in] freq spi running frequence, 0 is the device default
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the spi mode is set by spi_init
+ */
+uint8_t spi_prepared_init(spi_prepared_t *p, int fd, uint32_t freq)
+{
+    if (p == NULL)
+    {
+        return 1;
+    }
+    
+    /* clear the transaction */
+    memset(p, 0, sizeof(spi_prepared_t));
+    
+    /* set the param */
+    p->fd = fd;
+    p->freq = freq;
+    
+    return 0;
+}
+
+/**
+ * @brief     spi prepared transaction add a transfer
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @param[in] *tx pointer to a tx buffer, NULL sends zeros
+ * @param[in] *rx pointer to a rx buffer, NULL drops the received data
+ * @param[in] len length of the data buffer
+ * @param[in] cs_change 1 releases cs after this transfer
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+uint8_t spi_prepared_add(spi_prepared_t *p, uint8_t *tx, uint8_t *rx, uint32_t len, uint8_t cs_change)
+{
+    struct spi_ioc_transfer *k;
+    
+    if ((p == NULL) || (p->num >= SPI_PREPARED_MAX_TRANSFERS))
+    {
+        return 1;
+    }
+    
+    /* set the transfer */
+    k = &p->k[p->num];
+    k->tx_buf = (unsigned long)tx;
+    k->rx_buf = (unsigned long)rx;
+    k->len = len;
+    k->speed_hz = p->freq;
+    k->cs_change = cs_change;
+    p->num++;
+    p->len += len;
+    
+    return 0;
+}
+
+/**
+ * @brief     spi prepared transaction set the buffers of a transfer
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @param[in] index transfer index
+ * @param[in] *tx pointer to a tx buffer, NULL sends zeros
+ * @param[in] *rx pointer to a rx buffer, NULL drops the received data
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the length and the other settings are kept
+ */
+uint8_t spi_prepared_set_buffer(spi_prepared_t *p, uint32_t index, uint8_t *tx, uint8_t *rx)
+{
+    if ((p == NULL) || (index >= p->num))
+    {
+        return 1;
+    }
+    
+    /* set the buffers */
+    p->k[index].tx_buf = (unsigned long)tx;
+    p->k[index].rx_buf = (unsigned long)rx;
+    
+    return 0;
+}
+
+/**
+ * @brief     spi prepared transaction run
+ * @param[in] *p pointer to a spi prepared transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      all transfers are sent in one ioctl and the transaction can be run again
+ */
+uint8_t spi_prepared_run(spi_prepared_t *p)
+{
+    int l;
+    
+    if ((p == NULL) || (p->num == 0))
+    {
+        return 1;
+    }
+    
+    /* transmit */
+    l = ioctl(p->fd, SPI_IOC_MESSAGE(p->num), p->k);
+    if (l != (int)p->len)
+    {
+        perror("spi: length check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -171,27 +285,16 @@ uint8_t spi_deinit(int fd)
  */
 uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    int l;
+    spi_prepared_t p;
     
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
-    
-    /* set the param */
-    k.rx_buf = (unsigned long)buf;
-    k.len = len;
-    k.cs_change = 0;
-    
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, NULL, buf, len, 0) != 0)
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    return 0;
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -207,37 +310,20 @@ uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
-    uint8_t recv[len + 1];
-    int l;
-    
-    /* set the command */
-    command[0] = reg;
-    memset(&command[1], 0x00, len);
+    spi_prepared_t p;
     
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
-    
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.rx_buf = (unsigned long)recv;
-    k.len = len + 1;
-    k.cs_change = 0;
-    
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, &reg, NULL, 1, 0) != 0)
+    {
+        return 1;
+    }
+    if ((len > 0) && (spi_prepared_add(&p, NULL, buf, len, 0) != 0))
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    /* copy the data */
-    memcpy(buf, recv + 1, len);
-    
-    return 0;
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -253,38 +339,25 @@ uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 2];
-    uint8_t recv[len + 2];
-    int l;
+    spi_prepared_t p;
+    uint8_t command[2];
     
     /* set the command */
     command[0] = (reg >> 8) & 0xFF;
     command[1] = reg & 0xFF;
-    memset(&command[2], 0x00, len);
-    
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.rx_buf = (unsigned long)recv;
-    k.len = len + 2;
-    k.cs_change = 0;
-    
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, command, NULL, 2, 0) != 0)
+    {
+        return 1;
+    }
+    if ((len > 0) && (spi_prepared_add(&p, NULL, buf, len, 0) != 0))
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    /* copy the data */
-    memcpy(buf, recv + 2, len);
-    
-    return 0;
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -299,27 +372,16 @@ uint8_t spi_read_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    int l;
+    spi_prepared_t p;
     
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(k));
-    
-    /* set the param */
-    k.tx_buf = (unsigned long)buf;
-    k.len = len;
-    k.cs_change = 0;
-    
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, buf, NULL, len, 0) != 0)
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    return 0;
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -335,32 +397,20 @@ uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
-    int l;
-    
-    /* set the command */
-    command[0] = reg;
-    memcpy(&command[1], buf, len);
-    
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
-    
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.len = len + 1;
-    k.cs_change = 0;
+    spi_prepared_t p;
     
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, &reg, NULL, 1, 0) != 0)
+    {
+        return 1;
+    }
+    if ((len > 0) && (spi_prepared_add(&p, buf, NULL, len, 0) != 0))
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    return 0;
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -376,33 +426,25 @@ uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 2];
-    int l;
+    spi_prepared_t p;
+    uint8_t command[2];
     
     /* set the command */
     command[0] = (reg >> 8) & 0xFF;
     command[1] = reg & 0xFF;
-    memcpy(&command[2], buf, len);
-    
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.len = len + 2;
-    k.cs_change = 0;
-    
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, command, NULL, 2, 0) != 0)
+    {
+        return 1;
+    }
+    if ((len > 0) && (spi_prepared_add(&p, buf, NULL, len, 0) != 0))
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    return 0;
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -419,61 +461,25 @@ uint8_t spi_write_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len)
 {
-    if ((in_len > 0) && (out_len > 0))
+    spi_prepared_t p;
+    
+    if (in_len == 0)
     {
-        struct spi_ioc_transfer k[2];
-        int l;
-        
-        /* clear ioc transfer */
-        memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
-        
-        /* set the param */
-        k[0].tx_buf = (unsigned long)in_buf;
-        k[0].len = in_len;
-        k[0].cs_change = 0;
-        k[1].rx_buf = (unsigned long)out_buf;
-        k[1].len = out_len;
-        k[1].cs_change = 0;
-        
-        /* transmit */
-        l = ioctl(fd, SPI_IOC_MESSAGE(2), &k);
-        if (l != (k[0].len + k[1].len))
-        {
-            perror("spi: length check error.\n");
-            
-            return 1;
-        }
-        
-        return 0;
+        return 1;
     }
-    else if (in_len > 0)
+    
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, in_buf, NULL, in_len, 0) != 0)
     {
-        struct spi_ioc_transfer k;
-        int l;
-        
-        /* clear ioc transfer */
-        memset(&k, 0, sizeof(struct spi_ioc_transfer));
-        
-        /* set the param */
-        k.tx_buf = (unsigned long)in_buf;
-        k.len = in_len;
-        k.cs_change = 0;
-        
-        /* transmit */
-        l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-        if (l != k.len)
-        {
-            perror("spi: length check error.\n");
-            
-            return 1;
-        }
-        
-        return 0;
+        return 1;
     }
-    else
+    if ((out_len > 0) && (spi_prepared_add(&p, NULL, out_buf, out_len, 0) != 0))
     {
         return 1;
     }
+    
+    return spi_prepared_run(&p);
 }
 
 /**
@@ -489,26 +495,14 @@ uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_bu
  */
 uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len)
 {
-    int l;
-    struct spi_ioc_transfer k;
-    
-    /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
-    
-    /* set the param */
-    k.tx_buf = (unsigned long)tx;
-    k.rx_buf = (unsigned long)rx;
-    k.len = len;
-    k.cs_change = 0;
+    spi_prepared_t p;
     
-    /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    /* prepare the transaction */
+    (void)spi_prepared_init(&p, fd, 0);
+    if (spi_prepared_add(&p, tx, rx, len, 0) != 0)
     {
-        perror("spi: length check error.\n");
-        
         return 1;
     }
     
-    return 0;
+    return spi_prepared_run(&p);
 }
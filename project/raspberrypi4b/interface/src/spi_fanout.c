@@ -0,0 +1,453 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      spi_fanout.c
+ * @brief     spi fanout source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "spi_fanout.h"
+#if (SPI_FANOUT_GPIOD == 1)
+#include <gpiod.h>
+#endif
+
+/**
+ * @brief spi fanout consumer definition
+ */
+#define SPI_FANOUT_CONSUMER        "max6675"        /**< gpio consumer name */
+
+#if (SPI_FANOUT_GPIOD == 1)
+
+/**
+ * @brief spi fanout gpiod structure definition
+ */
+typedef struct spi_fanout_gpiod_s
+{
+    struct gpiod_chip *chip;            /**< gpio chip */
+    struct gpiod_line_bulk bulk;        /**< cs lines */
+} spi_fanout_gpiod_t;
+
+/**
+ * @brief     gpiod set all cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      one syscall for all lines
+ */
+static uint8_t a_spi_fanout_gpiod_set(spi_fanout_t *fanout)
+{
+    spi_fanout_gpiod_t *g = (spi_fanout_gpiod_t *)fanout->gpio;
+    
+    if (gpiod_line_set_value_bulk(&g->bulk, fanout->values) < 0)
+    {
+        perror("spi_fanout: set cs failed");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     gpiod release the cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @note      none
+ */
+static void a_spi_fanout_gpiod_release(spi_fanout_t *fanout)
+{
+    spi_fanout_gpiod_t *g = (spi_fanout_gpiod_t *)fanout->gpio;
+    
+    gpiod_line_release_bulk(&g->bulk);
+    gpiod_chip_close(g->chip);
+    free(g);
+    fanout->gpio = NULL;
+}
+
+/**
+ * @brief      spidev read from the selected line
+ * @param[in]  *fanout pointer to a spi fanout structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_spi_fanout_spidev_transfer(spi_fanout_t *fanout, uint8_t *buf, uint16_t len)
+{
+    if (len != fanout->read.len)
+    {
+        return spi_read_cmd(fanout->fd, buf, len);
+    }
+    (void)spi_prepared_set_buffer(&fanout->read, 0, NULL, buf);
+    
+    return spi_prepared_run(&fanout->read);
+}
+
+#endif
+
+/**
+ * @brief     simulator set all cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_spi_fanout_sim_set(spi_fanout_t *fanout)
+{
+    fanout->sim->sets++;
+    
+    return 0;
+}
+
+/**
+ * @brief      simulator read from the selected line
+ * @param[in]  *fanout pointer to a spi fanout structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the bus floats high when no line or more than one line is selected
+ */
+static uint8_t a_spi_fanout_sim_transfer(spi_fanout_t *fanout, uint8_t *buf, uint16_t len)
+{
+    spi_fanout_sim_t *sim = fanout->sim;
+    int32_t line;
+    uint16_t low;
+    uint16_t i;
+    
+    sim->transfers++;
+    low = 0;
+    line = -1;
+    for (i = 0; i < fanout->num; i++)
+    {
+        if (fanout->values[i] == 0)
+        {
+            low++;
+            line = i;
+        }
+    }
+    memset(buf, 0xFF, len);
+    if (low != 1)
+    {
+        sim->errors++;
+        
+        return 0;
+    }
+    if (len >= 2)
+    {
+        buf[0] = (sim->frame[line] >> 8) & 0xFF;
+        buf[1] = (sim->frame[line] >> 0) & 0xFF;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     select one line
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @param[in] line cs line, -1 releases all lines
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the previous line is released in the same bulk set
+ */
+static uint8_t a_spi_fanout_select(spi_fanout_t *fanout, int32_t line)
+{
+    if (fanout->selected >= 0)
+    {
+        fanout->values[fanout->selected] = 1;
+    }
+    if (line >= 0)
+    {
+        fanout->values[line] = 0;
+    }
+    fanout->selected = line;
+    
+    return fanout->cs_set(fanout);
+}
+
+/**
+ * @brief     spi fanout init with libgpiod cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @param[in] *name pointer to a spi device name buffer
+ * @param[in] freq spi running frequence
+ * @param[in] *chip pointer to a gpio chip name buffer
+ * @param[in] *offsets pointer to a cs line offset list
+ * @param[in] num cs line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      spidev runs with SPI_NO_CS and all cs lines are requested as one bulk output,
+ *            active low and deselected
+ */
+uint8_t spi_fanout_init(spi_fanout_t *fanout, char *name, uint32_t freq,
+                        char *chip, const unsigned int *offsets, uint16_t num)
+{
+#if (SPI_FANOUT_GPIOD == 1)
+    spi_fanout_gpiod_t *g;
+    uint16_t i;
+    
+    if ((fanout == NULL) || (name == NULL) || (chip == NULL) || (offsets == NULL) ||
+        (num == 0) || (num > SPI_FANOUT_MAX_LINES))
+    {
+        return 1;
+    }
+    
+    /* deselect all lines */
+    memset(fanout, 0, sizeof(spi_fanout_t));
+    fanout->name = name;
+    fanout->num = num;
+    fanout->selected = -1;
+    for (i = 0; i < num; i++)
+    {
+        fanout->values[i] = 1;
+    }
+    
+    /* request the cs lines as one bulk */
+    g = (spi_fanout_gpiod_t *)malloc(sizeof(spi_fanout_gpiod_t));
+    if (g == NULL)
+    {
+        return 1;
+    }
+    g->chip = gpiod_chip_open_lookup(chip);
+    if (g->chip == NULL)
+    {
+        perror("spi_fanout: open chip failed");
+        free(g);
+        
+        return 1;
+    }
+    if (gpiod_chip_get_lines(g->chip, (unsigned int *)offsets, num, &g->bulk) < 0)
+    {
+        perror("spi_fanout: get lines failed");
+        gpiod_chip_close(g->chip);
+        free(g);
+        
+        return 1;
+    }
+    if (gpiod_line_request_bulk_output(&g->bulk, SPI_FANOUT_CONSUMER, fanout->values) < 0)
+    {
+        perror("spi_fanout: request lines failed");
+        gpiod_chip_close(g->chip);
+        free(g);
+        
+        return 1;
+    }
+    fanout->gpio = g;
+    fanout->cs_set = a_spi_fanout_gpiod_set;
+    fanout->release = a_spi_fanout_gpiod_release;
+    
+    /* open the bus without the hardware cs */
+    if (spi_init(name, &fanout->fd, (spi_mode_type_t)(SPI_MODE_TYPE_0 | SPI_NO_CS), freq) != 0)
+    {
+        fanout->release(fanout);
+        
+        return 1;
+    }
+    (void)spi_prepared_init(&fanout->read, fanout->fd, 0);
+    (void)spi_prepared_add(&fanout->read, NULL, NULL, 2, 0);
+    fanout->transfer = a_spi_fanout_spidev_transfer;
+    
+    return 0;
+#else
+    (void)fanout;
+    (void)name;
+    (void)freq;
+    (void)chip;
+    (void)offsets;
+    (void)num;
+    fprintf(stderr, "spi_fanout: built without libgpiod.\n");
+    
+    return 1;
+#endif
+}
+
+/**
+ * @brief     spi fanout init with simulated cs lines
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @param[in] *sim pointer to a spi fanout simulator structure
+ * @param[in] *name pointer to a spi device name buffer
+ * @param[in] num cs line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      no spi or gpio device is opened, every transfer returns the frame of the selected
+ *            line and checks that exactly one line is selected
+ */
+uint8_t spi_fanout_sim_init(spi_fanout_t *fanout, spi_fanout_sim_t *sim, char *name, uint16_t num)
+{
+    uint16_t i;
+    
+    if ((fanout == NULL) || (sim == NULL) || (num == 0) || (num > SPI_FANOUT_MAX_LINES))
+    {
+        return 1;
+    }
+    
+    /* deselect all lines */
+    memset(fanout, 0, sizeof(spi_fanout_t));
+    fanout->name = name;
+    fanout->fd = -1;
+    fanout->num = num;
+    fanout->selected = -1;
+    for (i = 0; i < num; i++)
+    {
+        fanout->values[i] = 1;
+    }
+    
+    /* link the simulator */
+    sim->sets = 0;
+    sim->transfers = 0;
+    sim->errors = 0;
+    fanout->sim = sim;
+    fanout->cs_set = a_spi_fanout_sim_set;
+    fanout->transfer = a_spi_fanout_sim_transfer;
+    
+    return 0;
+}
+
+/**
+ * @brief     spi fanout deinit
+ * @param[in] *fanout pointer to a spi fanout structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t spi_fanout_deinit(spi_fanout_t *fanout)
+{
+    uint8_t res;
+    
+    if (fanout == NULL)
+    {
+        return 1;
+    }
+    
+    res = 0;
+    if (fanout->fd >= 0)
+    {
+        res = spi_deinit(fanout->fd);
+        fanout->fd = -1;
+    }
+    if (fanout->release != NULL)
+    {
+        fanout->release(fanout);
+        fanout->release = NULL;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      spi fanout read one line
+ * @param[in]  *fanout pointer to a spi fanout structure
+ * @param[in]  line cs line
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       two bulk sets, one selects the line and one releases it
+ */
+uint8_t spi_fanout_read(spi_fanout_t *fanout, uint16_t line, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if ((fanout == NULL) || (line >= fanout->num))
+    {
+        return 1;
+    }
+    
+    if (a_spi_fanout_select(fanout, line) != 0)
+    {
+        return 1;
+    }
+    res = fanout->transfer(fanout, buf, len);
+    
+    /* release the line, the conversion restarts on the rising edge */
+    if (a_spi_fanout_select(fanout, -1) != 0)
+    {
+        return 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      spi fanout read many lines
+ * @param[in]  *fanout pointer to a spi fanout structure
+ * @param[out] *buf pointer to a data buffer with num * len bytes
+ * @param[in]  len length of one frame
+ * @param[in]  num line number, lines 0 to num - 1 are read
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the release of a line and the select of the next one share one bulk set,
+ *             so num lines cost num + 1 gpio calls instead of 2 * num
+ */
+uint8_t spi_fanout_read_many(spi_fanout_t *fanout, uint8_t *buf, uint16_t len, uint16_t num)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    if ((fanout == NULL) || (num > fanout->num))
+    {
+        return 1;
+    }
+    
+    res = 0;
+    for (i = 0; i < num; i++)
+    {
+        /* release the previous line and select this one */
+        if (a_spi_fanout_select(fanout, i) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+        if (fanout->transfer(fanout, buf + i * len, len) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+    }
+    
+    /* release the last line */
+    if (a_spi_fanout_select(fanout, -1) != 0)
+    {
+        return 1;
+    }
+    
+    return res;
+}
@@ -36,9 +36,233 @@
 
 #include "driver_max6675_read_test.h"
 #include "driver_max6675_basic.h"
+#include "decode_benchmark.h"
+#include "filter_benchmark.h"
+#include "sampler_benchmark.h"
+#include "fanout_benchmark.h"
+#include "sim_benchmark.h"
+#include "history_benchmark.h"
+#include "shm_benchmark.h"
+#include "daemon_benchmark.h"
+#include "metrics_benchmark.h"
+#include "format_benchmark.h"
+#include "periodic.h"
+#include "rt.h"
+#include "raspberrypi4b_driver_max6675_interface.h"
+#include "raspberrypi4b_driver_max6675_history.h"
+#include "raspberrypi4b_driver_max6675_shm.h"
+#include "raspberrypi4b_driver_max6675_server.h"
+#include "raspberrypi4b_driver_max6675_metrics.h"
+#include "raspberrypi4b_driver_max6675_format.h"
+#include <fcntl.h>
 #include <getopt.h>
+#include <signal.h>
 #include <stdlib.h>
 
+/**
+ * @brief capture period definition
+ */
+#define MAX6675_CAPTURE_PERIOD_MS        250        /**< just longer than one conversion */
+
+/**
+ * @brief device definition
+ */
+#define MAX6675_MAX_DEVICES        16                  /**< max devices of one publisher or daemon */
+#define MAX6675_DEVICE_NAME        "/dev/spidev0.0"    /**< default device */
+
+/**
+ * @brief stream definition
+ */
+#define MAX6675_STREAM_BUFFER_SIZE        65536        /**< text output buffer size */
+#define MAX6675_STREAM_FLUSH_MS           1000         /**< longest time a sample is buffered */
+
+/**
+ * @brief stream format enumeration definition
+ */
+typedef enum
+{
+    MAX6675_STREAM_FORMAT_TEXT    = 0x00,        /**< one readable line per sample */
+    MAX6675_STREAM_FORMAT_CSV     = 0x01,        /**< csv with a header line */
+    MAX6675_STREAM_FORMAT_BINARY  = 0x02,        /**< trace records */
+    MAX6675_STREAM_FORMAT_HISTORY = 0x03,        /**< delta coded history chunks */
+    MAX6675_STREAM_FORMAT_JSON    = 0x04,        /**< one json object per line */
+} max6675_stream_format_t;
+
+/**
+ * @brief stream stop flag definition
+ */
+static volatile sig_atomic_t gs_stream_stop = 0;        /**< set by SIGINT or SIGTERM */
+
+/**
+ * @brief     stream signal handler
+ * @param[in] sig signal number
+ * @note      the stream ends after the current sample and the buffered samples are written
+ */
+static void a_max6675_stream_signal(int sig)
+{
+    (void)sig;
+    gs_stream_stop = 1;
+}
+
+/**
+ * @brief     serve the metrics scrapes
+ * @param[in] *arg pointer to a metrics structure
+ * @note      called by the daemon event loop when a scrape is waiting
+ */
+static void a_max6675_metrics_watch(void *arg)
+{
+    (void)raspberrypi4b_max6675_metrics_poll((raspberrypi4b_max6675_metrics_t *)arg, 0);
+}
+
+/**
+ * @brief     enter the real time mode
+ * @param[in] *config pointer to a rt config structure
+ * @note      the settings that can not be applied are reported and the sampling goes on
+ */
+static void a_max6675_rt_enter(const rt_config_t *config)
+{
+    uint8_t applied;
+    
+    if (rt_setup(config, &applied) != 0)
+    {
+        max6675_interface_debug_print("max6675: rt mode is partly applied.\n");
+    }
+    max6675_interface_debug_print("max6675: rt fifo %s, mlock %s, stack %s, cpu %s.\n",
+                                  (applied & RT_APPLIED_FIFO) ? "on" : "off",
+                                  (applied & RT_APPLIED_MLOCK) ? "on" : "off",
+                                  (applied & RT_APPLIED_STACK) ? "on" : "off",
+                                  (applied & RT_APPLIED_CPU) ? "on" : "off");
+}
+
+/**
+ * @brief     report the achieved jitter
+ * @param[in] *stats pointer to a periodic statistics structure
+ * @note      none
+ */
+static void a_max6675_rt_report(const periodic_stats_t *stats)
+{
+    max6675_interface_debug_print("max6675: jitter min %0.1fus max %0.1fus p99 %0.1fus, %u overrun.\n",
+                                  stats->min_ns / 1000.0, stats->max_ns / 1000.0,
+                                  stats->p99_ns / 1000.0, stats->overrun);
+}
+
+/**
+ * @brief     run the devices on simulators
+ * @param[in] *sim pointer to a simulator array
+ * @param[in] num simulator number
+ * @note      a slowly drifting room temperature on the virtual clock, every simulator has an own seed
+ *            and the first one is also the default device
+ */
+static void a_max6675_sim_enter(raspberrypi4b_max6675_sim_t *sim, uint32_t num)
+{
+    uint32_t i;
+    
+    raspberrypi4b_max6675_sim_set_virtual_clock(1);
+    for (i = 0; i < num; i++)
+    {
+        (void)raspberrypi4b_max6675_sim_init(&sim[i], 6675 + i);
+        sim[i].wave = RASPBERRYPI4B_MAX6675_SIM_WAVE_SINE;
+        sim[i].base = 26.0f + (float)i;
+        sim[i].amplitude = 1.0f;
+        sim[i].period_ms = 60000;
+        sim[i].noise = 0.25f;
+    }
+    raspberrypi4b_max6675_set_sim(sim);
+}
+
+/**
+ * @brief     go back to the bus
+ * @param[in] *sim pointer to a simulator array
+ * @param[in] num simulator number
+ * @note      none
+ */
+static void a_max6675_sim_leave(raspberrypi4b_max6675_sim_t *sim, uint32_t num)
+{
+    uint32_t aborted = 0;
+    uint32_t reads = 0;
+    uint32_t i;
+    
+    raspberrypi4b_max6675_set_sim(NULL);
+    raspberrypi4b_max6675_sim_set_virtual_clock(0);
+    for (i = 0; i < num; i++)
+    {
+        aborted += sim[i].aborted;
+        reads += sim[i].reads;
+    }
+    max6675_interface_debug_print("max6675: sim aborted %u of %u conversions.\n", aborted, reads);
+}
+
+/**
+ * @brief     init the handles of the devices
+ * @param[in] *handle pointer to a max6675 handle array
+ * @param[in] *device pointer to a device array
+ * @param[in] *sim pointer to a simulator array, NULL reads the spidev devices
+ * @param[in] **name pointer to the spidev names
+ * @param[in] num device number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every handle owns its device or simulator and keeps its own read status and statistics,
+ *            the handles that are inited before a failure are closed again
+ */
+static uint8_t a_max6675_devices_init(max6675_handle_t *handle, raspberrypi4b_max6675_device_t *device,
+                                      raspberrypi4b_max6675_sim_t *sim, char **name, uint32_t num)
+{
+    uint32_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        DRIVER_MAX6675_LINK_INIT(&handle[i], max6675_handle_t);
+        if (sim != NULL)
+        {
+            DRIVER_MAX6675_LINK_SPI_INIT(&handle[i], raspberrypi4b_max6675_sim_spi_init);
+            DRIVER_MAX6675_LINK_SPI_DEINIT(&handle[i], raspberrypi4b_max6675_sim_spi_deinit);
+            DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&handle[i], raspberrypi4b_max6675_sim_spi_read_cmd);
+            DRIVER_MAX6675_LINK_CONTEXT(&handle[i], &sim[i]);
+        }
+        else
+        {
+            RASPBERRYPI4B_MAX6675_DEVICE_INIT(&device[i], name[i]);
+            DRIVER_MAX6675_LINK_SPI_INIT(&handle[i], raspberrypi4b_max6675_spidev_spi_init);
+            DRIVER_MAX6675_LINK_SPI_DEINIT(&handle[i], raspberrypi4b_max6675_spidev_spi_deinit);
+            DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&handle[i], raspberrypi4b_max6675_spidev_spi_read_cmd);
+            DRIVER_MAX6675_LINK_CONTEXT(&handle[i], &device[i]);
+        }
+        DRIVER_MAX6675_LINK_DELAY_MS(&handle[i], max6675_interface_delay_ms);
+        DRIVER_MAX6675_LINK_GET_TICK_MS(&handle[i], max6675_interface_get_tick_ms);
+        DRIVER_MAX6675_LINK_DEBUG_PRINT(&handle[i], max6675_interface_debug_print);
+        if (max6675_init(&handle[i]) != 0)
+        {
+            max6675_interface_debug_print("max6675: %s init failed.\n", name[i]);
+            while (i > 0)
+            {
+                i--;
+                (void)max6675_deinit(&handle[i]);
+            }
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     deinit the handles of the devices
+ * @param[in] *handle pointer to a max6675 handle array
+ * @param[in] num device number
+ * @note      none
+ */
+static void a_max6675_devices_deinit(max6675_handle_t *handle, uint32_t num)
+{
+    uint32_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        (void)max6675_deinit(&handle[i]);
+    }
+}
+
 /**
  * @brief     max6675 full function
  * @param[in] argc arg numbers
@@ -53,19 +277,49 @@ uint8_t max6675(uint8_t argc, char **argv)
 {
     int c;
     int longindex = 0;
-    const char short_options[] = "hipe:t:";
+    const char short_options[] = "b:hipe:t:";
     const struct option long_options[] =
     {
+        {"benchmark", required_argument, NULL, 'b'},
         {"help", no_argument, NULL, 'h'},
         {"information", no_argument, NULL, 'i'},
         {"port", no_argument, NULL, 'p'},
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
         {"times", required_argument, NULL, 1},
+        {"priority", required_argument, NULL, 2},
+        {"cpu", required_argument, NULL, 3},
+        {"sim", no_argument, NULL, 4},
+        {"file", required_argument, NULL, 5},
+        {"speed", required_argument, NULL, 6},
+        {"interval", required_argument, NULL, 7},
+        {"duration", required_argument, NULL, 8},
+        {"format", required_argument, NULL, 9},
+        {"name", required_argument, NULL, 10},
+        {"socket", required_argument, NULL, 11},
+        {"decimate", required_argument, NULL, 12},
+        {"metrics", required_argument, NULL, 13},
+        {"device", required_argument, NULL, 14},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
+    uint8_t rt_enable = 0;
+    rt_config_t rt = {0, -1, 0, 0};
+    uint8_t sim_enable = 0;
+    char *file = NULL;
+    float speed = 1.0f;
+    uint32_t interval = MAX6675_CAPTURE_PERIOD_MS;
+    uint32_t duration = 0;
+    max6675_stream_format_t format = MAX6675_STREAM_FORMAT_TEXT;
+    char *name = RASPBERRYPI4B_MAX6675_SHM_NAME;
+    char *path = RASPBERRYPI4B_MAX6675_SERVER_SOCKET;
+    uint32_t decimate = 1;
+    uint8_t metrics_enable = 0;
+    char metrics_address[16] = {0};
+    uint16_t metrics_port = RASPBERRYPI4B_MAX6675_METRICS_PORT;
+    char *device[MAX6675_MAX_DEVICES] = {MAX6675_DEVICE_NAME};
+    uint32_t devices = 0;
     
     /* if no params */
     if (argc == 1)
@@ -86,6 +340,16 @@ uint8_t max6675(uint8_t argc, char **argv)
         /* judge the result */
         switch (c)
         {
+            /* benchmark */
+            case 'b' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "b_%s", optarg);
+                
+                break;
+            }
+            
             /* help */
             case 'h' :
             {
@@ -145,6 +409,200 @@ uint8_t max6675(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* rt priority */
+            case 2 :
+            {
+                /* set the priority */
+                rt.priority = atoi(optarg);
+                if ((rt.priority < 1) || (rt.priority > 99))
+                {
+                    return 5;
+                }
+                rt.lock_memory = 1;
+                rt.prefault_stack = 1;
+                rt_enable = 1;
+                
+                break;
+            }
+            
+            /* rt cpu */
+            case 3 :
+            {
+                /* set the cpu */
+                rt.cpu = atoi(optarg);
+                if (rt.cpu < 0)
+                {
+                    return 5;
+                }
+                rt_enable = 1;
+                
+                break;
+            }
+            
+            /* simulator */
+            case 4 :
+            {
+                /* run on the simulator */
+                sim_enable = 1;
+                
+                break;
+            }
+            
+            /* trace file */
+            case 5 :
+            {
+                /* set the file */
+                file = optarg;
+                
+                break;
+            }
+            
+            /* replay speed */
+            case 6 :
+            {
+                /* set the speed */
+                speed = (float)atof(optarg);
+                if (speed < 0.0f)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* stream interval */
+            case 7 :
+            {
+                /* set the interval */
+                interval = atol(optarg);
+                if (interval == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* stream duration */
+            case 8 :
+            {
+                /* set the duration */
+                duration = atol(optarg);
+                
+                break;
+            }
+            
+            /* stream format */
+            case 9 :
+            {
+                /* set the format */
+                if (strcmp("text", optarg) == 0)
+                {
+                    format = MAX6675_STREAM_FORMAT_TEXT;
+                }
+                else if (strcmp("csv", optarg) == 0)
+                {
+                    format = MAX6675_STREAM_FORMAT_CSV;
+                }
+                else if (strcmp("binary", optarg) == 0)
+                {
+                    format = MAX6675_STREAM_FORMAT_BINARY;
+                }
+                else if (strcmp("history", optarg) == 0)
+                {
+                    format = MAX6675_STREAM_FORMAT_HISTORY;
+                }
+                else if (strcmp("json", optarg) == 0)
+                {
+                    format = MAX6675_STREAM_FORMAT_JSON;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* shared memory name */
+            case 10 :
+            {
+                /* set the name */
+                name = optarg;
+                if ((name[0] != '/') || (strlen(name) >= sizeof(((raspberrypi4b_max6675_shm_t *)0)->name)))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* server socket */
+            case 11 :
+            {
+                /* set the socket path */
+                path = optarg;
+                
+                break;
+            }
+            
+            /* subscription decimation */
+            case 12 :
+            {
+                /* set the decimation */
+                decimate = atol(optarg);
+                if ((decimate == 0) || (decimate > RASPBERRYPI4B_MAX6675_SERVER_MAX_DECIMATION))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* metrics listener */
+            case 13 :
+            {
+                char *colon;
+                
+                /* set the address and the port */
+                colon = strrchr(optarg, ':');
+                if (colon != NULL)
+                {
+                    if ((size_t)(colon - optarg) >= sizeof(metrics_address))
+                    {
+                        return 5;
+                    }
+                    memcpy(metrics_address, optarg, (size_t)(colon - optarg));
+                    metrics_address[colon - optarg] = '\0';
+                    metrics_port = (uint16_t)atol(colon + 1);
+                }
+                else
+                {
+                    metrics_port = (uint16_t)atol(optarg);
+                }
+                if (metrics_port == 0)
+                {
+                    return 5;
+                }
+                metrics_enable = 1;
+                
+                break;
+            }
+            
+            /* spidev device */
+            case 14 :
+            {
+                /* add the device */
+                if (devices >= MAX6675_MAX_DEVICES)
+                {
+                    return 5;
+                }
+                device[devices] = optarg;
+                devices++;
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -158,27 +616,63 @@ uint8_t max6675(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* the default device */
+    if (devices == 0)
+    {
+        devices = 1;
+    }
 
     /* run the function */
     if (strcmp("t_read", type) == 0)
     {
         uint8_t res;
+        periodic_stats_t stats;
+        raspberrypi4b_max6675_sim_t sim;
+        
+        /* enter the rt mode */
+        if (rt_enable != 0)
+        {
+            a_max6675_rt_enter(&rt);
+        }
+        
+        /* run on the simulator */
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_enter(&sim, 1);
+        }
         
         /* run the read test */
         res = max6675_read_test(times);
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_leave(&sim, 1);
+        }
         if (res != 0)
         {
             return 1;
         }
-        else
+        
+        /* report the jitter */
+        if ((rt_enable != 0) && (raspberrypi4b_max6675_get_wait_stats(&stats) == 0))
         {
-            return 0;
+            a_max6675_rt_report(&stats);
         }
+        
+        return 0;
     }
     else if (strcmp("e_read", type) == 0)
     {
         uint8_t res;
         uint32_t i;
+        periodic_t period;
+        periodic_stats_t stats;
+        
+        /* enter the rt mode */
+        if (rt_enable != 0)
+        {
+            a_max6675_rt_enter(&rt);
+        }
         
         /* init */
         res = max6675_basic_init();
@@ -187,6 +681,9 @@ uint8_t max6675(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* sample every 1000ms */
+        (void)periodic_init(&period, 1000ULL * 1000 * 1000);
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
@@ -205,15 +702,911 @@ uint8_t max6675(uint8_t argc, char **argv)
             /* output */
             max6675_interface_debug_print("%d/%d %0.2fC.\n", i + 1, times, temp);
             
-            /* delay 1000ms */
-            max6675_interface_delay_ms(1000);
+            /* wait for the next period */
+            (void)periodic_wait(&period);
         }
         
         /* deinit */
         (void)max6675_basic_deinit();
         
+        /* report the jitter */
+        if ((rt_enable != 0) && (periodic_get_stats(&period, &stats) == 0))
+        {
+            a_max6675_rt_report(&stats);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_capture", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t tick;
+        static raspberrypi4b_max6675_capture_t capture;
+        raspberrypi4b_max6675_sim_t sim;
+        
+        /* check the file */
+        if (file == NULL)
+        {
+            return 5;
+        }
+        
+        /* run on the simulator */
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_enter(&sim, 1);
+        }
+        
+        /* record every frame */
+        res = raspberrypi4b_max6675_capture_open(&capture, file);
+        if (res != 0)
+        {
+            if (sim_enable != 0)
+            {
+                a_max6675_sim_leave(&sim, 1);
+            }
+            
+            return 1;
+        }
+        raspberrypi4b_max6675_set_capture(&capture);
+        
+        /* init */
+        res = max6675_basic_init();
+        if (res == 0)
+        {
+            /* sample once per conversion and keep the faults in the trace */
+            tick = max6675_interface_get_tick_ms();
+            for (i = 0; i < times; i++)
+            {
+                uint16_t raw;
+                float temp;
+                
+                /* read data */
+                if (max6675_basic_read(&raw, &temp) != 0)
+                {
+                    max6675_interface_debug_print("%d/%d read failed.\n", i + 1, times);
+                }
+                else
+                {
+                    max6675_interface_debug_print("%d/%d %0.2fC.\n", i + 1, times, temp);
+                }
+                
+                /* wait for the next conversion */
+                tick += MAX6675_CAPTURE_PERIOD_MS;
+                max6675_interface_wait_until_ms(tick);
+            }
+            
+            /* deinit */
+            (void)max6675_basic_deinit();
+        }
+        
+        /* close the trace */
+        raspberrypi4b_max6675_set_capture(NULL);
+        if (raspberrypi4b_max6675_capture_close(&capture) != 0)
+        {
+            res = 1;
+        }
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_leave(&sim, 1);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+        max6675_interface_debug_print("max6675: captured %u frames to %s.\n", capture.frames, file);
+        
         return 0;
     }
+    else if (strcmp("e_replay", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint64_t start;
+        static raspberrypi4b_max6675_replay_t replay;
+        
+        /* check the file */
+        if (file == NULL)
+        {
+            return 5;
+        }
+        
+        /* map the trace */
+        res = raspberrypi4b_max6675_replay_open(&replay, file, speed);
+        if (res != 0)
+        {
+            return 1;
+        }
+        raspberrypi4b_max6675_set_replay(&replay);
+        
+        /* init */
+        res = max6675_basic_init();
+        if (res != 0)
+        {
+            raspberrypi4b_max6675_set_replay(NULL);
+            (void)raspberrypi4b_max6675_replay_close(&replay);
+            
+            return 1;
+        }
+        
+        /* play the trace */
+        start = periodic_now_ns();
+        for (i = 0; (i < times) && (raspberrypi4b_max6675_replay_end(&replay) == 0); i++)
+        {
+            uint16_t raw;
+            float temp;
+            
+            /* read data */
+            if (max6675_basic_read(&raw, &temp) != 0)
+            {
+                max6675_interface_debug_print("%d/%d read failed.\n", i + 1, times);
+            }
+            else
+            {
+                max6675_interface_debug_print("%d/%d %0.2fC.\n", i + 1, times, temp);
+            }
+        }
+        
+        /* deinit */
+        (void)max6675_basic_deinit();
+        raspberrypi4b_max6675_set_replay(NULL);
+        max6675_interface_debug_print("max6675: replayed %u of %u frames in %0.3fs.\n", replay.index, replay.count,
+                                      (double)(periodic_now_ns() - start) / 1000000000.0);
+        (void)raspberrypi4b_max6675_replay_close(&replay);
+        
+        return 0;
+    }
+    else if (strcmp("e_stream", type) == 0)
+    {
+        uint8_t res;
+        int fd;
+        FILE *fp;
+        uint32_t tick;
+        uint32_t end;
+        uint32_t flush;
+        uint32_t samples;
+        struct sigaction sa;
+        periodic_stats_t stats;
+        static char buf[MAX6675_STREAM_BUFFER_SIZE];
+        static raspberrypi4b_max6675_capture_t capture;
+        static raspberrypi4b_max6675_history_writer_t history;
+        static raspberrypi4b_max6675_format_t lines;
+        raspberrypi4b_max6675_sim_t sim;
+        
+        /* a history is appended to a file */
+        if ((format == MAX6675_STREAM_FORMAT_HISTORY) && (file == NULL))
+        {
+            return 5;
+        }
+        
+        /* open the output, on stdout the messages move to stderr */
+        if (format == MAX6675_STREAM_FORMAT_HISTORY)
+        {
+            fd = (raspberrypi4b_max6675_history_open(&history, file) == 0) ? history.fd : -1;
+        }
+        else if (file != NULL)
+        {
+            fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        }
+        else
+        {
+            (void)fflush(stdout);
+            fd = dup(STDOUT_FILENO);
+            (void)dup2(STDERR_FILENO, STDOUT_FILENO);
+        }
+        if (fd < 0)
+        {
+            perror("max6675: stream open failed");
+            
+            return 1;
+        }
+        fp = NULL;
+        if (format == MAX6675_STREAM_FORMAT_BINARY)
+        {
+            /* every frame is written as a trace record */
+            (void)raspberrypi4b_max6675_capture_open_fd(&capture, fd);
+            raspberrypi4b_max6675_set_capture(&capture);
+        }
+        else if (format == MAX6675_STREAM_FORMAT_HISTORY)
+        {
+            /* the samples are written in whole chunks */
+        }
+        else if ((format == MAX6675_STREAM_FORMAT_CSV) || (format == MAX6675_STREAM_FORMAT_JSON))
+        {
+            /* the lines are formatted without printf into one reused buffer */
+            (void)raspberrypi4b_max6675_format_open_fd(&lines, fd, (format == MAX6675_STREAM_FORMAT_CSV) ?
+                                                       RASPBERRYPI4B_MAX6675_FORMAT_CSV : RASPBERRYPI4B_MAX6675_FORMAT_JSON);
+        }
+        else
+        {
+            fp = fdopen(fd, "w");
+            if (fp == NULL)
+            {
+                (void)close(fd);
+                
+                return 1;
+            }
+            (void)setvbuf(fp, buf, _IOFBF, MAX6675_STREAM_BUFFER_SIZE);
+        }
+        
+        /* stop cleanly on ctrl-c */
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = a_max6675_stream_signal;
+        (void)sigaction(SIGINT, &sa, NULL);
+        (void)sigaction(SIGTERM, &sa, NULL);
+        
+        /* enter the rt mode, the messages are already off the stream output */
+        if (rt_enable != 0)
+        {
+            a_max6675_rt_enter(&rt);
+        }
+        
+        /* run on the simulator */
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_enter(&sim, 1);
+        }
+        
+        /* init */
+        samples = 0;
+        res = max6675_basic_init();
+        if (res == 0)
+        {
+            /* sample on absolute deadlines until the duration is over */
+            tick = max6675_interface_get_tick_ms();
+            end = tick + duration * 1000;
+            flush = tick;
+            while ((gs_stream_stop == 0) && ((duration == 0) || ((int32_t)(end - tick) > 0)))
+            {
+                uint16_t raw;
+                float temp;
+                
+                /* read data, a failed read keeps raw 0 */
+                raw = 0;
+                res = max6675_basic_read(&raw, &temp);
+                if (format == MAX6675_STREAM_FORMAT_TEXT)
+                {
+                    if (res != 0)
+                    {
+                        (void)fprintf(fp, "%u ms read failed.\n", tick);
+                    }
+                    else
+                    {
+                        (void)fprintf(fp, "%u ms %0.2fC.\n", tick, temp);
+                    }
+                }
+                else if ((format == MAX6675_STREAM_FORMAT_CSV) || (format == MAX6675_STREAM_FORMAT_JSON))
+                {
+                    (void)raspberrypi4b_max6675_format_write(&lines, tick, 0, raw, res);
+                }
+                else if (format == MAX6675_STREAM_FORMAT_HISTORY)
+                {
+                    (void)raspberrypi4b_max6675_history_write(&history, tick, (res != 0) ? 0 : raw, res);
+                }
+                else
+                {
+                    /* the capture has recorded the frame */
+                }
+                samples++;
+                
+                /* write the buffered samples at least once per flush time, a history keeps whole chunks */
+                if ((tick - flush) >= MAX6675_STREAM_FLUSH_MS)
+                {
+                    flush = tick;
+                    if (fp != NULL)
+                    {
+                        (void)fflush(fp);
+                    }
+                    else if ((format == MAX6675_STREAM_FORMAT_CSV) || (format == MAX6675_STREAM_FORMAT_JSON))
+                    {
+                        (void)raspberrypi4b_max6675_format_flush(&lines);
+                    }
+                    else if (format == MAX6675_STREAM_FORMAT_BINARY)
+                    {
+                        (void)raspberrypi4b_max6675_capture_flush(&capture);
+                    }
+                    else
+                    {
+                        /* written when the chunk is full */
+                    }
+                }
+                
+                /* wait for the next sample */
+                tick += interval;
+                max6675_interface_wait_until_ms(tick);
+            }
+            
+            /* deinit */
+            (void)max6675_basic_deinit();
+        }
+        
+        /* close the output */
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_leave(&sim, 1);
+        }
+        if (fp != NULL)
+        {
+            if (fclose(fp) != 0)
+            {
+                res = 1;
+            }
+        }
+        else if ((format == MAX6675_STREAM_FORMAT_CSV) || (format == MAX6675_STREAM_FORMAT_JSON))
+        {
+            if (raspberrypi4b_max6675_format_close(&lines) != 0)
+            {
+                res = 1;
+            }
+        }
+        else if (format == MAX6675_STREAM_FORMAT_HISTORY)
+        {
+            if (raspberrypi4b_max6675_history_close(&history) != 0)
+            {
+                res = 1;
+            }
+        }
+        else
+        {
+            raspberrypi4b_max6675_set_capture(NULL);
+            if (raspberrypi4b_max6675_capture_close(&capture) != 0)
+            {
+                res = 1;
+            }
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+        max6675_interface_debug_print("max6675: streamed %u samples.\n", samples);
+        
+        /* report the jitter */
+        if ((rt_enable != 0) && (raspberrypi4b_max6675_get_wait_stats(&stats) == 0))
+        {
+            a_max6675_rt_report(&stats);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_history", type) == 0)
+    {
+        uint32_t i;
+        uint32_t chunks;
+        uint64_t samples;
+        const uint8_t *payload;
+        raspberrypi4b_max6675_history_chunk_t chunk;
+        static raspberrypi4b_max6675_history_reader_t reader;
+        static uint32_t tick[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES];
+        static uint16_t raw[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES];
+        static uint8_t status[RASPBERRYPI4B_MAX6675_HISTORY_CHUNK_SAMPLES];
+        static raspberrypi4b_max6675_format_t lines;
+        
+        /* check the file */
+        if (file == NULL)
+        {
+            return 5;
+        }
+        
+        /* map the history */
+        if (raspberrypi4b_max6675_history_reader_open(&reader, file) != 0)
+        {
+            return 1;
+        }
+        
+        /* print every chunk as csv */
+        (void)fflush(stdout);
+        if (raspberrypi4b_max6675_format_open_fd(&lines, dup(STDOUT_FILENO), RASPBERRYPI4B_MAX6675_FORMAT_CSV) != 0)
+        {
+            (void)raspberrypi4b_max6675_history_reader_close(&reader);
+            
+            return 1;
+        }
+        chunks = 0;
+        samples = 0;
+        while (raspberrypi4b_max6675_history_reader_next(&reader, &chunk, &payload) == 0)
+        {
+            if (raspberrypi4b_max6675_history_decode(&chunk, payload, tick, raw, status) != 0)
+            {
+                (void)fprintf(stderr, "max6675: chunk %u is malformed.\n", chunks);
+                
+                break;
+            }
+            for (i = 0; i < chunk.count; i++)
+            {
+                (void)raspberrypi4b_max6675_format_write(&lines, tick[i], 0, raw[i], status[i]);
+            }
+            chunks++;
+            samples += chunk.count;
+        }
+        (void)raspberrypi4b_max6675_format_close(&lines);
+        (void)fprintf(stderr, "max6675: read %llu samples in %u chunks.\n", (unsigned long long)samples, chunks);
+        (void)raspberrypi4b_max6675_history_reader_close(&reader);
+        
+        return 0;
+    }
+    else if (strcmp("e_publish", type) == 0)
+    {
+        uint8_t res;
+        uint8_t init;
+        uint32_t tick;
+        uint32_t end;
+        uint32_t samples;
+        uint32_t i;
+        struct sigaction sa;
+        periodic_stats_t stats;
+        static raspberrypi4b_max6675_shm_t shm;
+        static max6675_handle_t handle[MAX6675_MAX_DEVICES];
+        static raspberrypi4b_max6675_device_t dev[MAX6675_MAX_DEVICES];
+        static raspberrypi4b_max6675_sim_t sim[MAX6675_MAX_DEVICES];
+        
+        /* create the segment with one slot per device */
+        if (raspberrypi4b_max6675_shm_create(&shm, name, devices) != 0)
+        {
+            return 1;
+        }
+        
+        /* stop cleanly on ctrl-c */
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = a_max6675_stream_signal;
+        (void)sigaction(SIGINT, &sa, NULL);
+        (void)sigaction(SIGTERM, &sa, NULL);
+        
+        /* enter the rt mode */
+        if (rt_enable != 0)
+        {
+            a_max6675_rt_enter(&rt);
+        }
+        
+        /* run on the simulators */
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_enter(sim, devices);
+        }
+        
+        /* init */
+        samples = 0;
+        init = a_max6675_devices_init(handle, dev, (sim_enable != 0) ? sim : NULL, device, devices);
+        if (init == 0)
+        {
+            /* the only bus reader, every process gets the samples from the segment */
+            tick = max6675_interface_get_tick_ms();
+            end = tick + duration * 1000;
+            while ((gs_stream_stop == 0) && ((duration == 0) || ((int32_t)(end - tick) > 0)))
+            {
+                /* read and publish every device into its slot */
+                for (i = 0; i < devices; i++)
+                {
+                    uint16_t raw;
+                    float temp;
+                    
+                    raw = 0;
+                    res = max6675_read(&handle[i], &raw, &temp);
+                    (void)raspberrypi4b_max6675_shm_publish(&shm, i, tick, (res != 0) ? 0 : raw, res);
+                    samples++;
+                }
+                
+                /* wait for the next sample */
+                tick += interval;
+                max6675_interface_wait_until_ms(tick);
+            }
+            
+            /* deinit */
+            a_max6675_devices_deinit(handle, devices);
+        }
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_leave(sim, devices);
+        }
+        (void)raspberrypi4b_max6675_shm_close(&shm);
+        if (init != 0)
+        {
+            return 1;
+        }
+        max6675_interface_debug_print("max6675: published %u samples to %s.\n", samples, name);
+        
+        /* report the jitter */
+        if ((rt_enable != 0) && (raspberrypi4b_max6675_get_wait_stats(&stats) == 0))
+        {
+            a_max6675_rt_report(&stats);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_snapshot", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        raspberrypi4b_max6675_shm_sample_t sample;
+        static raspberrypi4b_max6675_shm_t shm;
+        
+        /* map the segment */
+        if (raspberrypi4b_max6675_shm_open(&shm, name) != 0)
+        {
+            return 1;
+        }
+        
+        /* print the latest sample of every sensor */
+        for (i = 0; i < shm.seg->num; i++)
+        {
+            /* 4 only means that the publisher overtook this reader, so read again */
+            do
+            {
+                res = raspberrypi4b_max6675_shm_read(&shm, i, &sample);
+            } while (res == 4);
+            if (res != 0)
+            {
+                max6675_interface_debug_print("%u: snapshot failed.\n", i);
+            }
+            else if (sample.count == 0)
+            {
+                max6675_interface_debug_print("%u: no sample.\n", i);
+            }
+            else if (sample.status != 0)
+            {
+                max6675_interface_debug_print("%u: %u ms read failed with %d, %u samples.\n", i, sample.tick,
+                                              sample.status, sample.count);
+            }
+            else
+            {
+                max6675_interface_debug_print("%u: %u ms %d.%02dC, %u samples.\n", i, sample.tick,
+                                              sample.temp / 100, sample.temp % 100, sample.count);
+            }
+        }
+        (void)raspberrypi4b_max6675_shm_close(&shm);
+        
+        return 0;
+    }
+    else if (strcmp("e_daemon", type) == 0)
+    {
+        uint8_t res;
+        uint8_t init;
+        uint32_t tick;
+        uint32_t end;
+        uint32_t samples;
+        uint32_t events;
+        uint32_t i;
+        struct sigaction sa;
+        periodic_stats_t stats;
+        static max6675_handle_t handle[MAX6675_MAX_DEVICES];
+        static raspberrypi4b_max6675_device_t dev[MAX6675_MAX_DEVICES];
+        static raspberrypi4b_max6675_sim_t sim[MAX6675_MAX_DEVICES];
+        static raspberrypi4b_max6675_server_t server;
+        static raspberrypi4b_max6675_metrics_t metrics;
+        
+        /* listen for the subscribers */
+        if (raspberrypi4b_max6675_server_open(&server, path) != 0)
+        {
+            return 1;
+        }
+        
+        /* the scrapes are served from the same event loop */
+        if (metrics_enable != 0)
+        {
+            if (raspberrypi4b_max6675_metrics_open(&metrics, (metrics_address[0] != '\0') ? metrics_address : NULL,
+                                                   metrics_port, devices) != 0)
+            {
+                (void)raspberrypi4b_max6675_server_close(&server);
+                
+                return 1;
+            }
+            (void)raspberrypi4b_max6675_server_watch(&server, metrics.epfd, a_max6675_metrics_watch, &metrics);
+        }
+        
+        /* stop cleanly on ctrl-c */
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = a_max6675_stream_signal;
+        (void)sigaction(SIGINT, &sa, NULL);
+        (void)sigaction(SIGTERM, &sa, NULL);
+        
+        /* enter the rt mode */
+        if (rt_enable != 0)
+        {
+            a_max6675_rt_enter(&rt);
+        }
+        
+        /* run on the simulators */
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_enter(sim, devices);
+        }
+        
+        /* init, an own handle per device keeps the read status and the statistics */
+        res = 0;
+        samples = 0;
+        init = a_max6675_devices_init(handle, dev, (sim_enable != 0) ? sim : NULL, device, devices);
+        if (init == 0)
+        {
+            tick = max6675_interface_get_tick_ms();
+            end = tick + duration * 1000;
+            while ((gs_stream_stop == 0) && (res == 0) && ((duration == 0) || ((int32_t)(end - tick) > 0)))
+            {
+                /* read every device once for every subscriber, the device index is the sensor id */
+                for (i = 0; i < devices; i++)
+                {
+                    uint16_t raw;
+                    float temp;
+                    uint8_t status;
+                    uint64_t start;
+                    uint64_t latency;
+                    max6675_stats_t read_stats;
+                    
+                    /* an open input keeps its flag and other failures go out as a zero frame */
+                    raw = 0;
+                    start = periodic_now_ns();
+                    status = max6675_read(&handle[i], &raw, &temp);
+                    latency = periodic_now_ns() - start;
+                    (void)raspberrypi4b_max6675_server_publish(&server, tick,
+                                                               (status == 0) ? (uint16_t)(raw << 3) : ((status == 4) ? 0x0004 : 0),
+                                                               (uint8_t)i, status);
+                    if (metrics_enable != 0)
+                    {
+                        (void)max6675_get_stats(&handle[i], &read_stats);
+                        (void)raspberrypi4b_max6675_metrics_update(&metrics, i, raw, status, latency, &read_stats);
+                    }
+                    samples++;
+                }
+                (void)raspberrypi4b_max6675_server_flush(&server);
+                
+                /* serve the subscribers until the next sample is due */
+                tick += interval;
+                while (gs_stream_stop == 0)
+                {
+                    int32_t wait;
+                    
+                    wait = (int32_t)(tick - max6675_interface_get_tick_ms());
+                    if (wait <= 0)
+                    {
+                        break;
+                    }
+                    if (raspberrypi4b_max6675_server_poll(&server, wait, &events) != 0)
+                    {
+                        res = 1;
+                        
+                        break;
+                    }
+                    if (events == 0)
+                    {
+                        break;
+                    }
+                }
+                
+                /* wake up on the deadline, this records the lateness and a virtual clock catches up here */
+                if ((gs_stream_stop == 0) && (res == 0))
+                {
+                    max6675_interface_wait_until_ms(tick);
+                }
+            }
+            
+            /* deinit */
+            a_max6675_devices_deinit(handle, devices);
+        }
+        if (sim_enable != 0)
+        {
+            a_max6675_sim_leave(sim, devices);
+        }
+        max6675_interface_debug_print("max6675: daemon sent %u samples to %u subscribers, %u slow subscribers closed, %llu records dropped.\n",
+                                      samples, server.accepted, server.disconnected, (unsigned long long)server.dropped);
+        if (metrics_enable != 0)
+        {
+            max6675_interface_debug_print("max6675: metrics served %u scrapes on port %d.\n", metrics.scrapes, metrics.port);
+            (void)raspberrypi4b_max6675_metrics_close(&metrics);
+        }
+        (void)raspberrypi4b_max6675_server_close(&server);
+        if ((init != 0) || (res != 0))
+        {
+            return 1;
+        }
+        
+        /* report the jitter */
+        if ((rt_enable != 0) && (raspberrypi4b_max6675_get_wait_stats(&stats) == 0))
+        {
+            a_max6675_rt_report(&stats);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_subscribe", type) == 0)
+    {
+        uint32_t i;
+        uint32_t len;
+        int fd;
+        uint8_t rec[RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE];
+        
+        /* connect to the daemon */
+        if (raspberrypi4b_max6675_server_subscribe(path, decimate, &fd) != 0)
+        {
+            return 1;
+        }
+        
+        /* print the records */
+        for (i = 0; i < times; i++)
+        {
+            uint32_t tick;
+            uint16_t frame;
+            
+            len = 0;
+            while (len < RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE)
+            {
+                ssize_t n;
+                
+                n = read(fd, rec + len, RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE - len);
+                if (n <= 0)
+                {
+                    break;
+                }
+                len += (uint32_t)n;
+            }
+            if (len < RASPBERRYPI4B_MAX6675_TRACE_RECORD_SIZE)
+            {
+                max6675_interface_debug_print("max6675: daemon closed the subscription.\n");
+                
+                break;
+            }
+            tick = (uint32_t)rec[0] | ((uint32_t)rec[1] << 8) | ((uint32_t)rec[2] << 16) | ((uint32_t)rec[3] << 24);
+            frame = (uint16_t)(rec[4] | (rec[5] << 8));
+            if (rec[7] != 0)
+            {
+                max6675_interface_debug_print("%d/%d #%d %u ms read failed.\n", i + 1, times, rec[6], tick);
+            }
+            else
+            {
+                max6675_interface_debug_print("%d/%d #%d %u ms %0.2fC.\n", i + 1, times, rec[6], tick, (frame >> 3) * 0.25f);
+            }
+        }
+        (void)close(fd);
+        
+        return 0;
+    }
+    else if (strcmp("b_decode", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the decode benchmark */
+        res = decode_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_filter", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the filter benchmark */
+        res = filter_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_sampler", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the sampler benchmark */
+        res = sampler_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_fanout", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the fanout benchmark */
+        res = fanout_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_sim", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the simulator benchmark */
+        res = sim_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_history", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the history benchmark */
+        res = history_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_shm", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the shared memory benchmark */
+        res = shm_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_daemon", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the daemon benchmark */
+        res = daemon_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_metrics", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the metrics benchmark */
+        res = metrics_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b_format", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the format benchmark */
+        res = format_benchmark(times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -221,14 +1614,49 @@ uint8_t max6675(uint8_t argc, char **argv)
         max6675_interface_debug_print("  max6675 (-i | --information)\n");
         max6675_interface_debug_print("  max6675 (-h | --help)\n");
         max6675_interface_debug_print("  max6675 (-p | --port)\n");
-        max6675_interface_debug_print("  max6675 (-t read | --test=read) [--times=<num>]\n");
-        max6675_interface_debug_print("  max6675 (-e read | --example=read) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-t read | --test=read) [--times=<num>] [--priority=<1-99>] [--cpu=<num>] [--sim]\n");
+        max6675_interface_debug_print("  max6675 (-e read | --example=read) [--times=<num>] [--priority=<1-99>] [--cpu=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-e capture | --example=capture) --file=<path> [--times=<num>] [--sim]\n");
+        max6675_interface_debug_print("  max6675 (-e replay | --example=replay) --file=<path> [--times=<num>] [--speed=<x>]\n");
+        max6675_interface_debug_print("  max6675 (-e stream | --example=stream) [--interval=<ms>] [--duration=<s>] [--format=<text | csv | json | binary | history>] [--file=<path>] [--priority=<1-99>] [--cpu=<num>] [--sim]\n");
+        max6675_interface_debug_print("  max6675 (-e history | --example=history) --file=<path>\n");
+        max6675_interface_debug_print("  max6675 (-e publish | --example=publish) [--device=<path>]... [--name=<shm>] [--interval=<ms>] [--duration=<s>] [--priority=<1-99>] [--cpu=<num>] [--sim]\n");
+        max6675_interface_debug_print("  max6675 (-e snapshot | --example=snapshot) [--name=<shm>]\n");
+        max6675_interface_debug_print("  max6675 (-e daemon | --example=daemon) [--device=<path>]... [--socket=<path>] [--metrics=<[address:]port>] [--interval=<ms>] [--duration=<s>] [--priority=<1-99>] [--cpu=<num>] [--sim]\n");
+        max6675_interface_debug_print("  max6675 (-e subscribe | --example=subscribe) [--socket=<path>] [--decimate=<n>] [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b decode | --benchmark=decode) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b filter | --benchmark=filter) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b sampler | --benchmark=sampler) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b fanout | --benchmark=fanout) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b sim | --benchmark=sim) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b history | --benchmark=history) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b shm | --benchmark=shm) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b daemon | --benchmark=daemon) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b metrics | --benchmark=metrics) [--times=<num>]\n");
+        max6675_interface_debug_print("  max6675 (-b format | --benchmark=format) [--times=<num>]\n");
         max6675_interface_debug_print("\n");
         max6675_interface_debug_print("Options:\n");
-        max6675_interface_debug_print("  -e <read>, --example=<read>        Run the driver example.\n");
+        max6675_interface_debug_print("  -b <decode | filter | sampler | fanout | sim | history | shm | daemon | metrics | format>, --benchmark=<decode | filter | sampler | fanout | sim | history | shm | daemon | metrics | format>\n");
+        max6675_interface_debug_print("                                     Run the benchmark.\n");
+        max6675_interface_debug_print("      --cpu=<num>                    Pin the sampling thread to a cpu.\n");
+        max6675_interface_debug_print("      --decimate=<n>                 Subscribe to every n-th sample.([default: 1])\n");
+        max6675_interface_debug_print("      --device=<path>                Add a spidev device, the n-th device is sensor n-1.([default: /dev/spidev0.0])\n");
+        max6675_interface_debug_print("  -e <read | capture | replay | stream | history | publish | snapshot | daemon | subscribe>, --example=<read | capture | replay | stream | history | publish | snapshot | daemon | subscribe>\n");
+        max6675_interface_debug_print("                                     Run the driver example.\n");
+        max6675_interface_debug_print("      --duration=<s>                 Set the stream, publish or daemon duration, 0 runs until ctrl-c.([default: 0])\n");
+        max6675_interface_debug_print("      --file=<path>                  Set the trace, stream or history file.\n");
+        max6675_interface_debug_print("      --format=<text | csv | json | binary | history>\n");
+        max6675_interface_debug_print("                                     Set the stream format.([default: text])\n");
         max6675_interface_debug_print("  -h, --help                         Show the help.\n");
         max6675_interface_debug_print("  -i, --information                  Show the chip information.\n");
+        max6675_interface_debug_print("      --interval=<ms>                Set the stream, publish or daemon interval.([default: 250])\n");
+        max6675_interface_debug_print("      --metrics=<[address:]port>     Serve the OpenMetrics text on http://address:port/metrics.\n");
+        max6675_interface_debug_print("      --name=<shm>                   Set the shared memory name.([default: /max6675])\n");
         max6675_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
+        max6675_interface_debug_print("      --priority=<1-99>              Run the sampling thread in SCHED_FIFO with the memory locked.\n");
+        max6675_interface_debug_print("      --sim                          Run on a simulated chip with a virtual clock.\n");
+        max6675_interface_debug_print("      --socket=<path>                Set the daemon socket.([default: /tmp/max6675.sock])\n");
+        max6675_interface_debug_print("      --speed=<x>                    Set the replay speed, 0 plays as fast as possible.([default: 1.0])\n");
         max6675_interface_debug_print("  -t <read>, --test=<read>           Run the driver test.\n");
         max6675_interface_debug_print("      --times=<num>                  Set the running times.([default: 3])\n");
 
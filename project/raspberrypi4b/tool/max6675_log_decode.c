@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      max6675_log_decode.c
+ * @brief     max6675 binary log decoder source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_max6675.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief log record size definition
+ */
+#define LOG_DECODE_RECORD_SIZE        8        /**< 8 bytes */
+
+/**
+ * @brief     decode one record
+ * @param[in] *buf pointer to a little endian record
+ * @note      the record layout is the max6675_log_record_t of a little endian target
+ */
+static void a_log_decode_record(const uint8_t *buf)
+{
+    uint32_t tick;
+    uint16_t arg;
+    uint8_t msg;
+    uint8_t id;
+    const char *str;
+    size_t len;
+    
+    tick = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    arg = (uint16_t)(buf[4] | (buf[5] << 8));
+    msg = buf[6];
+    id = buf[7];
+    
+    /* find the message */
+    str = max6675_log_message(msg);
+    if (str == NULL)
+    {
+        printf("[%10u ms] #%u max6675: unknown message 0x%02X.\n", tick, id, msg);
+        
+        return;
+    }
+    
+    /* strip the line break */
+    len = strlen(str);
+    if ((len > 0) && (str[len - 1] == '\n'))
+    {
+        len--;
+    }
+    if (arg != 0)
+    {
+        printf("[%10u ms] #%u %.*s (0x%04X)\n", tick, id, (int)len, str, arg);
+    }
+    else
+    {
+        printf("[%10u ms] #%u %.*s\n", tick, id, (int)len, str);
+    }
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the log is read from the file in argv[1] or from the stdin
+ */
+int main(int argc, char **argv)
+{
+    FILE *fp;
+    uint8_t buf[LOG_DECODE_RECORD_SIZE];
+    size_t len;
+    
+    if (argc > 2)
+    {
+        fprintf(stderr, "Usage:\n  max6675_log_decode [<file>]\n");
+        
+        return 1;
+    }
+    
+    /* open the log */
+    if (argc == 2)
+    {
+        fp = fopen(argv[1], "rb");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "max6675_log_decode: open %s failed.\n", argv[1]);
+            
+            return 1;
+        }
+    }
+    else
+    {
+        fp = stdin;
+    }
+    
+    /* decode all records */
+    while ((len = fread(buf, 1, LOG_DECODE_RECORD_SIZE, fp)) == LOG_DECODE_RECORD_SIZE)
+    {
+        a_log_decode_record(buf);
+    }
+    if (len != 0)
+    {
+        fprintf(stderr, "max6675_log_decode: %u trailing bytes are ignored.\n", (unsigned int)len);
+    }
+    if (fp != stdin)
+    {
+        (void)fclose(fp);
+    }
+    
+    return 0;
+}
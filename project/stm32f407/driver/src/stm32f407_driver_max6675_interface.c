@@ -41,31 +41,34 @@
 #include <stdarg.h>
 
 /**
- * @brief  interface spi bus init
- * @return status code
- *         - 0 success
- *         - 1 spi init failed
- * @note   none
+ * @brief     interface spi bus init
+ * @param[in] *ctx pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
  */
-uint8_t max6675_interface_spi_init(void)
+uint8_t max6675_interface_spi_init(void *ctx)
 {
     return spi_init(SPI_MODE_0);
 }
 
 /**
- * @brief  interface spi bus deinit
- * @return status code
- *         - 0 success
- *         - 1 spi deinit failed
- * @note   none
+ * @brief     interface spi bus deinit
+ * @param[in] *ctx pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
  */
-uint8_t max6675_interface_spi_deinit(void)
+uint8_t max6675_interface_spi_deinit(void *ctx)
 {
     return spi_deinit();
 }
 
 /**
  * @brief      interface spi bus read command
+ * @param[in]  *ctx pointer to a user context
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len length of data buffer
  * @return     status code
@@ -73,11 +76,28 @@ uint8_t max6675_interface_spi_deinit(void)
  *             - 1 read failed
  * @note       none
  */
-uint8_t max6675_interface_spi_read_cmd(uint8_t *buf, uint16_t len)
+uint8_t max6675_interface_spi_read_cmd(void *ctx, uint8_t *buf, uint16_t len)
 {
     return spi_read_cmd(buf, len);
 }
 
+/**
+ * @brief      interface spi bus async read command
+ * @param[in]  *ctx pointer to a user context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @param[in]  *complete pointer to a completion function
+ * @param[in]  *param pointer to a completion parameter
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the complete function runs in the spi interrupt
+ */
+uint8_t max6675_interface_spi_read_cmd_async(void *ctx, uint8_t *buf, uint16_t len, void (*complete)(uint8_t res, void *param), void *param)
+{
+    return spi_read_cmd_async(buf, len, complete, param);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -88,6 +108,29 @@ void max6675_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief  interface get tick ms
+ * @return monotonic tick in ms
+ * @note   none
+ */
+uint32_t max6675_interface_get_tick_ms(void)
+{
+    return HAL_GetTick();
+}
+
+/**
+ * @brief     interface wait until a tick
+ * @param[in] tick absolute get_tick_ms tick
+ * @note      the core sleeps between the systick interrupts
+ */
+void max6675_interface_wait_until_ms(uint32_t tick)
+{
+    while ((int32_t)(tick - HAL_GetTick()) > 0)
+    {
+        __WFI();
+    }
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
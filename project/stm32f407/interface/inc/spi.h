@@ -125,6 +125,26 @@ uint8_t spi_write_address16(uint16_t addr, uint8_t *buf, uint16_t len);
  */
 uint8_t spi_read_cmd(uint8_t *buf, uint16_t len);
 
+/**
+ * @brief      spi bus async read command
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  *complete pointer to a completion function
+ * @param[in]  *param pointer to a completion parameter
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the complete function runs in the spi interrupt after cs is released
+ */
+uint8_t spi_read_cmd_async(uint8_t *buf, uint16_t len, void (*complete)(uint8_t res, void *param), void *param);
+
+/**
+ * @brief  spi get the handle
+ * @return pointer to a spi handle
+ * @note   none
+ */
+SPI_HandleTypeDef* spi_get_handle(void);
+
 /**
  * @brief      spi bus read
  * @param[in]  addr spi register address
@@ -39,7 +39,9 @@
 /**
  * @brief spi var definition
  */
-SPI_HandleTypeDef g_spi_handle;        /**< spi handle */
+SPI_HandleTypeDef g_spi_handle;                               /**< spi handle */
+static void (*gs_spi_complete)(uint8_t res, void *param);     /**< async completion function */
+static void *gs_spi_param;                                    /**< async completion parameter */
 
 /**
  * @brief  spi cs init
@@ -308,6 +310,86 @@ uint8_t spi_read_cmd(uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief      spi bus async read command
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  *complete pointer to a completion function
+ * @param[in]  *param pointer to a completion parameter
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the complete function runs in the spi interrupt after cs is released
+ */
+uint8_t spi_read_cmd_async(uint8_t *buf, uint16_t len, void (*complete)(uint8_t res, void *param), void *param)
+{
+    /* save the completion */
+    gs_spi_complete = complete;
+    gs_spi_param = param;
+    
+    /* set cs low */
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_RESET);
+    
+    /* start receiving to the buffer */
+    if (HAL_SPI_Receive_IT(&g_spi_handle, buf, len) != HAL_OK)
+    {
+        /* set cs high */
+        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+        gs_spi_complete = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spi finish the async transfer
+ * @param[in] res transfer result
+ * @note      none
+ */
+static void a_spi_async_finish(uint8_t res)
+{
+    void (*complete)(uint8_t res, void *param);
+    
+    /* set cs high */
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+    
+    /* run the completion */
+    complete = gs_spi_complete;
+    gs_spi_complete = NULL;
+    if (complete != NULL)
+    {
+        complete(res, gs_spi_param);
+    }
+}
+
+/**
+ * @brief     spi rx complete callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        a_spi_async_finish(0);
+    }
+}
+
+/**
+ * @brief     spi error callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        a_spi_async_finish(1);
+    }
+}
+
 /**
  * @brief      spi bus read
  * @param[in]  addr spi register address
@@ -495,3 +577,13 @@ uint8_t spi_write_read(uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint3
     
     return 0;
 }
+
+/**
+ * @brief  spi get the handle
+ * @return pointer to a spi handle
+ * @note   none
+ */
+SPI_HandleTypeDef* spi_get_handle(void)
+{
+    return &g_spi_handle;
+}
@@ -114,6 +114,12 @@ void USART1_IRQHandler(void);
  */
 void USART2_IRQHandler(void);
 
+/**
+ * @brief spi1 irq handler
+ * @note  none
+ */
+void SPI1_IRQHandler(void);
+
 /**
  * @}
  */
@@ -189,6 +189,7 @@ uint8_t max6675(uint8_t argc, char **argv)
     {
         uint8_t res;
         uint32_t i;
+        uint32_t deadline;
         
         /* init */
         res = max6675_basic_init();
@@ -197,6 +198,9 @@ uint8_t max6675(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* sample every 1000ms */
+        deadline = max6675_interface_get_tick_ms() + 1000;
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
@@ -215,8 +219,9 @@ uint8_t max6675(uint8_t argc, char **argv)
             /* output */
             max6675_interface_debug_print("%d/%d %0.2fC.\n", i + 1, times, temp);
             
-            /* delay 1000ms */
-            max6675_interface_delay_ms(1000);
+            /* wait for the next period */
+            max6675_interface_wait_until_ms(deadline);
+            deadline += 1000;
         }
         
         /* deinit */
@@ -175,6 +175,10 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef* hspi)
         GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
         GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+        
+        /* enable nvic */
+        HAL_NVIC_SetPriority(SPI1_IRQn, 3, 0);
+        HAL_NVIC_EnableIRQ(SPI1_IRQn);
     }
 }
 
@@ -192,6 +196,9 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef* hspi)
         
         /* spi gpio deinit */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
+        
+        /* disable nvic */
+        HAL_NVIC_DisableIRQ(SPI1_IRQn);
     }
 }
 
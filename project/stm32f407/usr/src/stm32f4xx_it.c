@@ -36,6 +36,7 @@
 
 #include "stm32f4xx_it.h"
 #include "uart.h"
+#include "spi.h"
 
 /**
  * @brief nmi handler
@@ -164,6 +165,15 @@ void USART2_IRQHandler(void)
     HAL_UART_IRQHandler(uart2_get_handle());
 }
 
+/**
+ * @brief spi1 irq handler
+ * @note  none
+ */
+void SPI1_IRQHandler(void)
+{
+    HAL_SPI_IRQHandler(spi_get_handle());
+}
+
 /**
  * @brief     uart error callback
  * @param[in] *huart pointer to a uart handle
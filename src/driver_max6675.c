@@ -48,6 +48,155 @@
 #define TEMPERATURE_MAX           85.0f                             /**< chip max operating temperature */
 #define DRIVER_VERSION            1000                              /**< driver version */
 
+/**
+ * @brief chip conversion time definition
+ */
+#define MAX6675_CONVERSION_TIME_MS        220        /**< max conversion time in ms */
+#define MAX6675_RETRY_DELAY_MS            1          /**< cs high time before a retry in ms */
+
+/**
+ * @brief log message table definition
+ */
+static const char *const gsc_max6675_log_message[MAX6675_LOG_MSG_MAX] =
+{
+    "max6675: spi_init is null.\n",                          /* spi_init is null */
+    "max6675: spi_deinit is null.\n",                        /* spi_deinit is null */
+    "max6675: spi_read_cmd is null.\n",                      /* spi_read_cmd is null */
+    "max6675: delay_ms is null.\n",                          /* delay_ms is null */
+    "max6675: get_tick_ms is null.\n",                       /* get_tick_ms is null */
+    "max6675: spi init failed.\n",                           /* spi init failed */
+    "max6675: spi deinit failed.\n",                         /* spi deinit failed */
+    "max6675: read data failed.\n",                          /* read data failed */
+    "max6675: thermocouple input is open.\n",                /* thermocouple input is open */
+    "max6675: fault is cleared.\n",                          /* fault is cleared */
+    "max6675: frame is corrupt.\n",                          /* frame is corrupt */
+};
+
+/**
+ * @brief     print a diagnostic message
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] msg message id
+ * @param[in] arg event argument
+ * @note      MAX6675_LOG_BINARY selects the binary record or the debug_print text
+ */
+static void a_max6675_print(max6675_handle_t *handle, max6675_log_msg_t msg, uint16_t arg)
+{
+#if (MAX6675_LOG_BINARY == 1)
+    max6675_log_t *log;
+    max6675_log_record_t *record;
+    
+    log = handle->log;                                                  /* get the log */
+    if (log == NULL)                                                    /* check the log */
+    {
+        return;                                                         /* return */
+    }
+    if (log->count >= log->size)                                        /* check the space */
+    {
+        log->dropped++;                                                 /* drop the record */
+        
+        return;                                                         /* return */
+    }
+    record = &log->buf[log->count];                                     /* get the record */
+    record->tick = (handle->get_tick_ms != NULL) ?
+                    handle->get_tick_ms() : 0;                          /* set the tick */
+    record->arg = arg;                                                  /* set the argument */
+    record->msg = (uint8_t)msg;                                         /* set the message id */
+    record->id = handle->log_id;                                        /* set the handle id */
+    log->count++;                                                       /* count the record */
+#else
+    (void)arg;                                                          /* text has no argument */
+    handle->debug_print("%s", gsc_max6675_log_message[msg]);            /* print the message */
+#endif
+}
+
+/**
+ * @brief     check a frame
+ * @param[in] frame chip register frame
+ * @return    1 if the frame is corrupt, else 0
+ * @note      the dummy sign bit D15 and the device id bit D1 are always 0,
+ *            0x0000 is a valid 0C frame because the chip clamps a sub-zero reading to it
+ */
+static uint8_t a_max6675_frame_corrupt(uint16_t frame)
+{
+    if ((frame & 0x8002) != 0)                               /* check the fixed bits */
+    {
+        return 1;                                            /* corrupt */
+    }
+    
+    return 0;                                                /* valid */
+}
+
+/**
+ * @brief     check a frame of a handle
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] frame chip register frame
+ * @return    1 if the frame is corrupt, else 0
+ * @note      0x0000 is also corrupt when the stuck low check of the handle is enabled
+ */
+static uint8_t a_max6675_handle_frame_corrupt(max6675_handle_t *handle, uint16_t frame)
+{
+    if ((handle->stuck_low != 0) && (frame == 0x0000))       /* check the stuck low miso line */
+    {
+        return 1;                                            /* corrupt */
+    }
+    
+    return a_max6675_frame_corrupt(frame);                   /* check the fixed bits */
+}
+
+/**
+ * @brief      decode a frame of a handle
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[in]  frame chip register frame
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 thermocouple input is open
+ *             - 6 frame is corrupt
+ * @note       none
+ */
+static uint8_t a_max6675_decode(max6675_handle_t *handle, uint16_t frame, uint16_t *raw)
+{
+    if (a_max6675_handle_frame_corrupt(handle, frame) != 0)       /* check the frame */
+    {
+        return 6;                                                 /* return error */
+    }
+    
+    return max6675_decode_frame(frame, raw);                      /* decode the frame */
+}
+
+/**
+ * @brief      finish a spi transaction
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[in]  res spi transaction result
+ * @param[in]  *buf pointer to the received bytes
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 spi read failed
+ * @note       none
+ */
+static uint8_t a_max6675_spi_finish(max6675_handle_t *handle, uint8_t res, const uint8_t *buf, uint16_t *data)
+{
+    if (handle->get_tick_ms != NULL)                                  /* check get_tick_ms */
+    {
+        handle->cache_tick = handle->get_tick_ms();                   /* a new conversion starts here */
+    }
+    if (res != 0)                                                     /* check result */
+    {
+        handle->cache_valid = 0;                                      /* invalidate the cache */
+        
+        return 1;                                                     /* return error */
+    }
+    else
+    {
+        *data = (((uint16_t)buf[0]) << 8) | buf[1];                   /* get the data */
+        handle->cache_data = *data;                                   /* save the frame */
+        handle->cache_valid = !a_max6675_handle_frame_corrupt(handle, *data);        /* never cache a corrupt frame */
+        
+        return 0;                                                     /* success return 0 */
+    }
+}
+
 /**
  * @brief      read bytes
  * @param[in]  *handle pointer to a max6675 handle structure
@@ -59,18 +208,299 @@
  */
 static uint8_t a_max6675_spi_read(max6675_handle_t *handle, uint16_t *data)
 {
+    uint8_t res;
     uint8_t buf[2];
     
-    if (handle->spi_read_cmd(buf, 2) != 0)                 /* spi read */
+    res = handle->spi_read_cmd(handle->ctx, buf, 2);             /* spi read */
+    
+    return a_max6675_spi_finish(handle, res, buf, data);         /* finish the transaction */
+}
+
+/**
+ * @brief     check the sample cache
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @return    1 if the cached frame is still the newest conversion, else 0
+ * @note      none
+ */
+static uint8_t a_max6675_cache_hit(max6675_handle_t *handle)
+{
+    if ((handle->cache_enable != 0) && (handle->cache_valid != 0) &&          /* check the cache */
+        ((handle->get_tick_ms() - handle->cache_tick) <                       /* check the conversion window */
+         MAX6675_CONVERSION_TIME_MS))
+    {
+        return 1;                                                             /* cache hit */
+    }
+    
+    return 0;                                                                 /* cache miss */
+}
+
+/**
+ * @brief     report a read result
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] frame chip register frame
+ * @param[in] status read status code
+ * @param[in] fresh 1 if the frame is read from the bus
+ * @note      a fresh frame is pushed into the attached ring and counted in the statistics
+ */
+static void a_max6675_report(max6675_handle_t *handle, uint16_t frame, uint8_t status, uint8_t fresh)
+{
+    uint8_t last;
+    max6675_sample_t sample;
+    
+    last = handle->fault_state;                                                    /* save the last state */
+    if (fresh != 0)                                                                /* check the new frame */
+    {
+        if (handle->ring != NULL)                                                  /* check the ring */
+        {
+            sample.tick = handle->cache_tick;                                      /* set the tick */
+            sample.frame = frame;                                                  /* set the frame */
+            sample.status = status;                                                /* set the status */
+            (void)max6675_ring_push(handle->ring, &sample);                        /* push the sample */
+        }
+        if (status == 1)                                                           /* spi failure */
+        {
+            handle->stats.spi_fail++;                                              /* count the failure */
+        }
+        else if (status == 4)                                                      /* thermocouple input is open */
+        {
+            handle->stats.open++;                                                  /* count the open event */
+        }
+        else if (status == 6)                                                      /* frame is corrupt */
+        {
+            handle->stats.corrupt++;                                               /* count the corrupt frame */
+        }
+        else
+        {
+            /* no fault */
+        }
+        if (status != 0)                                                           /* check the fault */
+        {
+            handle->stats.consecutive_fault++;                                     /* count the fault */
+            handle->stats.last_fault_tick = handle->cache_tick;                    /* save the fault tick */
+        }
+        else
+        {
+            handle->stats.consecutive_fault = 0;                                   /* clear the counter */
+        }
+        handle->fault_state = status;                                              /* save the state */
+    }
+    
+    if (handle->print_mode == (uint8_t)MAX6675_PRINT_MODE_NONE)                    /* no print */
+    {
+        return;                                                                    /* return */
+    }
+    if ((handle->print_mode == (uint8_t)MAX6675_PRINT_MODE_TRANSITION) &&
+        (last == handle->fault_state))                                             /* no state transition */
+    {
+        return;                                                                    /* return */
+    }
+    if (status == 1)                                                               /* spi failure */
+    {
+        a_max6675_print(handle, MAX6675_LOG_MSG_READ_FAILED, 0);                   /* read data failed */
+    }
+    else if (status == 4)                                                          /* thermocouple input is open */
+    {
+        a_max6675_print(handle, MAX6675_LOG_MSG_OPEN, frame);                      /* thermocouple input is open */
+    }
+    else if (status == 6)                                                          /* frame is corrupt */
+    {
+        a_max6675_print(handle, MAX6675_LOG_MSG_CORRUPT, frame);                   /* frame is corrupt */
+    }
+    else if (handle->print_mode == (uint8_t)MAX6675_PRINT_MODE_TRANSITION)         /* fault is cleared */
+    {
+        a_max6675_print(handle, MAX6675_LOG_MSG_FAULT_CLEARED, frame);                 /* fault is cleared */
+    }
+    else
+    {
+        /* no fault */
+    }
+}
+
+/**
+ * @brief      read the raw temperature
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
+ * @note       a spi failure or a corrupt frame is read again up to the retry times
+ */
+static uint8_t a_max6675_read(max6675_handle_t *handle, uint16_t *raw)
+{
+    uint8_t res;
+    uint8_t retry;
+    uint16_t data;
+    
+    if (handle->async_busy != 0)                                              /* check the async read */
+    {
+        return 5;                                                             /* return error */
+    }
+    if (a_max6675_cache_hit(handle) != 0)                                     /* check the cache */
+    {
+        data = handle->cache_data;                                            /* use the cached frame */
+        res = a_max6675_decode(handle, data, raw);                            /* decode the frame */
+        a_max6675_report(handle, data, res, 0);                               /* report the result */
+        
+        return res;                                                           /* return the result */
+    }
+    
+    retry = 0;                                                                /* init 0 */
+    while (1)                                                                 /* read with retry */
+    {
+        if (a_max6675_spi_read(handle, &data) != 0)                           /* read data */
+        {
+            data = 0x0000;                                                    /* no frame */
+            res = 1;                                                          /* read failed */
+        }
+        else
+        {
+            res = a_max6675_decode(handle, data, raw);                        /* decode the frame */
+        }
+        if (((res != 1) && (res != 6)) || (retry >= handle->retry))           /* check the retry */
+        {
+            break;                                                            /* break */
+        }
+        retry++;                                                              /* next retry */
+        handle->stats.retry++;                                                /* count the retry */
+        handle->delay_ms(MAX6675_RETRY_DELAY_MS);                             /* keep cs high */
+    }
+    a_max6675_report(handle, data, res, 1);                                   /* report the result */
+    
+    return res;                                                               /* return the result */
+}
+
+/**
+ * @brief     async read completion
+ * @param[in] res spi transaction result
+ * @param[in] *param pointer to a max6675 handle structure
+ * @note      it may run in the interrupt context
+ */
+static void a_max6675_async_complete(uint8_t res, void *param)
+{
+    max6675_handle_t *handle;
+    void (*callback)(uint8_t res, uint16_t raw, int32_t temp, void *ctx);
+    uint16_t data;
+    uint16_t raw;
+    
+    handle = (max6675_handle_t *)param;                                         /* get the handle */
+    raw = 0;                                                                    /* init 0 */
+    if (a_max6675_spi_finish(handle, res, handle->async_buf, &data) != 0)       /* finish the transaction */
     {
-        return 1;                                          /* return error */
+        res = 1;                                                                /* read failed */
+        a_max6675_report(handle, 0x0000, 1, 1);                                 /* report the failure */
     }
     else
     {
-        *data = (((uint16_t)buf[0]) << 8) | buf[1];        /* get the data */
+        res = a_max6675_decode(handle, data, &raw);                             /* decode the frame */
+        a_max6675_report(handle, data, res, 1);                                 /* report the result */
+    }
+    callback = handle->async_callback;                                          /* save the callback */
+    handle->async_busy = 0;                                                     /* flag idle */
+    callback(res, raw, (int32_t)raw * 25, handle->async_ctx);                   /* run the callback */
+}
+
+/**
+ * @brief      read the raw temperature of all devices in a group
+ * @param[in]  *group pointer to a max6675 group structure
+ * @param[out] *raw pointer to a raw data list with group num items
+ * @param[out] *status pointer to a status list with group num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 group, raw or status is NULL
+ *             - 3 handle is not initialized
+ * @note       1 means that the spi read of at least one device failed and the status list has
+ *             the result of every device, a busy handle or a cache hit needs its own read, so
+ *             the batch transfer is only used when every device needs a new frame, the frames
+ *             are received into the raw list, so raw item is set to 0 when its status is not 0
+ */
+static uint8_t a_max6675_read_many(max6675_group_t *group, uint16_t *raw, uint8_t *status)
+{
+    uint8_t res;
+    uint8_t batch;
+    uint16_t i;
+    uint16_t data;
+    uint8_t *buf;
+    max6675_handle_t *handle;
+    
+    if ((group == NULL) || (group->handle == NULL) || (group->num == 0))               /* check group */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if ((raw == NULL) || (status == NULL))                                             /* check raw and status */
+    {
+        return 2;                                                                      /* return error */
+    }
+    batch = (group->spi_read_many_cmd != NULL) ? 1 : 0;                                /* check the batch transfer */
+    for (i = 0; i < group->num; i++)                                                   /* check all handles */
+    {
+        handle = group->handle[i];                                                     /* get the handle */
+        if ((handle == NULL) || (handle->inited != 1))                                 /* check handle initialization */
+        {
+            return 3;                                                                  /* return error */
+        }
+        if ((handle->async_busy != 0) || (a_max6675_cache_hit(handle) != 0))           /* check busy and the cache */
+        {
+            batch = 0;                                                                 /* read one by one */
+        }
+    }
+    
+    if (batch == 0)                                                                    /* no batch transfer */
+    {
+        res = 0;                                                                       /* init 0 */
+        for (i = 0; i < group->num; i++)                                               /* read one by one */
+        {
+            status[i] = a_max6675_read(group->handle[i], &raw[i]);                     /* read data */
+            if (status[i] != 0)                                                        /* check the status */
+            {
+                raw[i] = 0;                                                            /* no valid data */
+            }
+            if (status[i] == 1)                                                        /* check the spi read */
+            {
+                res = 1;                                                               /* read failed */
+            }
+        }
         
-        return 0;                                          /* success return 0 */
+        return res;                                                                    /* return the result */
+    }
+    
+    buf = (uint8_t *)raw;                                                              /* frame i is decoded in place */
+    res = group->spi_read_many_cmd(group->ctx, buf, 2, group->num);                    /* read all frames */
+    for (i = 0; i < group->num; i++)                                                   /* update all handles */
+    {
+        handle = group->handle[i];                                                     /* get the handle */
+        if (handle->get_tick_ms != NULL)                                               /* check get_tick_ms */
+        {
+            handle->cache_tick = handle->get_tick_ms();                                /* a new conversion starts here */
+        }
+        if (res != 0)                                                                  /* check result */
+        {
+            handle->cache_valid = 0;                                                   /* invalidate the cache */
+            status[i] = 1;                                                             /* read failed */
+            raw[i] = 0;                                                                /* no valid data */
+            a_max6675_report(handle, 0x0000, 1, 1);                                    /* report the failure */
+            
+            continue;                                                                  /* next */
+        }
+        data = (((uint16_t)buf[i * 2]) << 8) | buf[i * 2 + 1];                         /* get the data */
+        handle->cache_data = data;                                                     /* save the frame */
+        handle->cache_valid = !a_max6675_handle_frame_corrupt(handle, data);           /* never cache a corrupt frame */
+        status[i] = a_max6675_decode(handle, data, &raw[i]);                           /* decode the frame */
+        if (status[i] != 0)                                                            /* check the status */
+        {
+            raw[i] = 0;                                                                /* clear the frame bytes */
+        }
+        a_max6675_report(handle, data, status[i], 1);                                  /* report the result */
+    }
+    if (res != 0)                                                                      /* check result */
+    {
+        return 1;                                                                      /* return error */
     }
+    
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
@@ -87,55 +517,65 @@ uint8_t max6675_init(max6675_handle_t *handle)
 {
     uint16_t data;
     
-    if (handle == NULL)                                                 /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                       /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->debug_print == NULL)                                    /* check debug_print */
+    if (handle->debug_print == NULL)                                          /* check debug_print */
     {
-        return 3;                                                       /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->spi_init == NULL)                                       /* check spi_init */
+    if (handle->spi_init == NULL)                                             /* check spi_init */
     {
-        handle->debug_print("max6675: spi_init is null.\n");            /* spi_init is null */
+        a_max6675_print(handle, MAX6675_LOG_MSG_SPI_INIT_NULL, 0);            /* spi_init is null */
        
-        return 3;                                                       /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->spi_deinit == NULL)                                     /* check spi_deinit */
+    if (handle->spi_deinit == NULL)                                           /* check spi_deinit */
     {
-        handle->debug_print("max6675: spi_deinit is null.\n");          /* spi_deinit is null */
+        a_max6675_print(handle, MAX6675_LOG_MSG_SPI_DEINIT_NULL, 0);          /* spi_deinit is null */
        
-        return 3;                                                       /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->spi_read_cmd == NULL)                                   /* check spi_read_cmd */
+    if (handle->spi_read_cmd == NULL)                                         /* check spi_read_cmd */
     {
-        handle->debug_print("max6675: spi_read_cmd is null.\n");        /* spi_read_cmd is null */
+        a_max6675_print(handle, MAX6675_LOG_MSG_SPI_READ_CMD_NULL, 0);        /* spi_read_cmd is null */
        
-        return 3;                                                       /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->delay_ms == NULL)                                       /* check delay_ms */
+    if (handle->delay_ms == NULL)                                             /* check delay_ms */
     {
-        handle->debug_print("max6675: delay_ms is null.\n");            /* delay_ms is null */
+        a_max6675_print(handle, MAX6675_LOG_MSG_DELAY_MS_NULL, 0);            /* delay_ms is null */
        
-        return 3;                                                       /* return error */
+        return 3;                                                             /* return error */
     }
     
-    if (handle->spi_init() != 0)                                        /* spi init */
+    handle->cache_enable = 0;                                                 /* disable the cache */
+    handle->ring = NULL;                                                      /* no ring */
+    memset(&handle->stats, 0, sizeof(max6675_stats_t));                       /* clear the statistics */
+    handle->fault_state = 0;                                                  /* no fault */
+    handle->print_mode = (uint8_t)MAX6675_PRINT_MODE_ALL;                     /* print all faults */
+    handle->async_busy = 0;                                                   /* no async read */
+    handle->retry = 0;                                                        /* no retry */
+    handle->stuck_low = 0;                                                    /* 0x0000 is 0C */
+    handle->cache_valid = 0;                                                  /* no cached frame */
+    
+    if (handle->spi_init(handle->ctx) != 0)                                   /* spi init */
     {
-        handle->debug_print("max6675: spi init failed.\n");             /* spi init failed */
+        a_max6675_print(handle, MAX6675_LOG_MSG_SPI_INIT_FAILED, 0);          /* spi init failed */
         
-        return 1;                                                       /* return error */
+        return 1;                                                             /* return error */
     }
-    if (a_max6675_spi_read(handle, &data) != 0)                         /* read data */
+    if (a_max6675_spi_read(handle, &data) != 0)                               /* read data */
     {
-        handle->debug_print("max6675: read data failed.\n");            /* read data failed */
+        a_max6675_print(handle, MAX6675_LOG_MSG_READ_FAILED, 0);              /* read data failed */
        
-        return 1;                                                       /* return error */
+        return 1;                                                             /* return error */
     }
     
-    handle->inited = 1;                                                 /* flag finish initialization */
+    handle->inited = 1;                                                       /* flag finish initialization */
     
-    return 0;                                                           /* success return 0 */
+    return 0;                                                                 /* success return 0 */
 }
 
 /**
@@ -146,33 +586,40 @@ uint8_t max6675_init(max6675_handle_t *handle)
  *            - 1 deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 read is busy
+ * @note      an async read in flight must complete before the spi is deinitialized
  */
 uint8_t max6675_deinit(max6675_handle_t *handle)
 {
     uint8_t res;
     
-    if (handle == NULL)                                              /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                    /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                         /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
+    }
+    if (handle->async_busy != 0)                                              /* check the async read */
+    {
+        return 4;                                                             /* return error */
     }
     
-    res = handle->spi_deinit();                                      /* spi deinit */
-    if (res != 0)                                                    /* check result */
+    res = handle->spi_deinit(handle->ctx);                                    /* spi deinit */
+    if (res != 0)                                                             /* check result */
     {
-        handle->debug_print("max6675: spi deinit failed.\n");        /* spi deinit failed */
+        a_max6675_print(handle, MAX6675_LOG_MSG_SPI_DEINIT_FAILED, 0);        /* spi deinit failed */
        
-        return 1;                                                    /* return error */
+        return 1;                                                             /* return error */
     }
-    handle->inited = 0;                                              /* flag close */
+    handle->cache_valid = 0;                                                  /* invalidate the cache */
+    handle->inited = 0;                                                       /* flag close */
     
-    return 0;                                                        /* success return 0 */
+    return 0;                                                                 /* success return 0 */
 }
 
+#if (MAX6675_FLOAT_SUPPORT == 1)
 /**
  * @brief      read the temperature
  * @param[in]  *handle pointer to a max6675 handle structure
@@ -184,64 +631,962 @@ uint8_t max6675_deinit(max6675_handle_t *handle)
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
  * @note       none
  */
 uint8_t max6675_read(max6675_handle_t *handle,uint16_t *raw, float *temp)
 {
     uint8_t res;
-    uint16_t data;
     
-    if (handle == NULL)                                                       /* check handle */
+    if (handle == NULL)                                  /* check handle */
     {
-        return 2;                                                             /* return error */
+        return 2;                                        /* return error */
     }
-    if (handle->inited != 1)                                                  /* check handle initialization */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        return 3;                                                             /* return error */
+        return 3;                                        /* return error */
     }
     
-    res = a_max6675_spi_read(handle, &data);                                  /* read data */
-    if (res != 0)                                                             /* check result */
-    {
-        handle->debug_print("max6675: read data failed.\n");                  /* read data failed */
-       
-        return 1;                                                             /* return error */
-    }
-    if ((data & (1 << 2)) != 0)                                               /* check the error */
+    res = a_max6675_read(handle, raw);                   /* read the raw data */
+    if (res != 0)                                        /* check result */
     {
-        handle->debug_print("max6675: thermocouple input is open.\n");        /* thermocouple input is open */
-       
-        return 4;                                                             /* return error */
+        return res;                                      /* return error */
     }
-    *raw = data >> 3;                                                         /* get the raw data */
-    *temp = (float)(*raw) * 0.25f;                                            /* convert data */
+    *temp = (float)(*raw) * 0.25f;                       /* convert data */
     
-    return 0;                                                                 /* success return 0 */
+    return 0;                                            /* success return 0 */
 }
+#endif
 
 /**
- * @brief      get the chip register
+ * @brief      read the temperature in fixed point
  * @param[in]  *handle pointer to a max6675 handle structure
- * @param[out] *data pointer to a data buffer
+ * @param[out] *raw pointer to a raw data buffer in 0.25C
+ * @param[out] *temp pointer to a temp buffer in 0.01C
  * @return     status code
  *             - 0 success
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
  * @note       none
  */
-uint8_t max6675_get_reg(max6675_handle_t *handle, uint16_t *data)
+uint8_t max6675_read_fixed(max6675_handle_t *handle, uint16_t *raw, int32_t *temp)
 {
-    if (handle == NULL)                            /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
     {
-        return 2;                                  /* return error */
+        return 2;                                        /* return error */
     }
-    if (handle->inited != 1)                       /* check handle initialization */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        return 3;                                  /* return error */
+        return 3;                                        /* return error */
     }
     
-    return a_max6675_spi_read(handle, data);       /* read data */
+    res = a_max6675_read(handle, raw);                   /* read the raw data */
+    if (res != 0)                                        /* check result */
+    {
+        return res;                                      /* return error */
+    }
+    *temp = (int32_t)(*raw) * 25;                        /* convert data */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     start an asynchronous temperature read
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *ctx pointer to a user context passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle or callback is NULL
+ *            - 3 handle is not initialized
+ *            - 4 read is busy
+ * @note      the callback gets the max6675_read_fixed status code, the raw data in 0.25C and
+ *            the temperature in 0.01C, it runs from the spi_read_cmd_async completion which
+ *            may be an interrupt, a cached frame or a handle without spi_read_cmd_async
+ *            completes synchronously before this function returns
+ */
+uint8_t max6675_read_async(max6675_handle_t *handle,
+                           void (*callback)(uint8_t res, uint16_t raw, int32_t temp, void *ctx),
+                           void *ctx)
+{
+    uint8_t res;
+    uint16_t raw;
+    
+    if ((handle == NULL) || (callback == NULL))                                        /* check handle and callback */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    if (handle->async_busy != 0)                                                       /* check the async read */
+    {
+        return 4;                                                                      /* return error */
+    }
+    
+    if ((handle->spi_read_cmd_async == NULL) || (a_max6675_cache_hit(handle) != 0))    /* check the sync path */
+    {
+        raw = 0;                                                                       /* init 0 */
+        res = a_max6675_read(handle, &raw);                                            /* read the raw data */
+        callback(res, raw, (int32_t)raw * 25, ctx);                                    /* run the callback */
+        
+        return 0;                                                                      /* success return 0 */
+    }
+    
+    handle->async_callback = callback;                                                 /* save the callback */
+    handle->async_ctx = ctx;                                                           /* save the context */
+    handle->async_busy = 1;                                                            /* flag busy */
+    res = handle->spi_read_cmd_async(handle->ctx, handle->async_buf, 2,
+                                     a_max6675_async_complete, handle);                /* start the read */
+    if (res != 0)                                                                      /* check result */
+    {
+        handle->async_busy = 0;                                                        /* flag idle */
+        handle->cache_valid = 0;                                                       /* invalidate the cache */
+        a_max6675_report(handle, 0x0000, 1, 1);                                        /* report the failure */
+        
+        return 1;                                                                      /* return error */
+    }
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     initialize a device group
+ * @param[in] *group pointer to a max6675 group structure
+ * @param[in] **handle pointer to a handle list
+ * @param[in] num handle number
+ * @return    status code
+ *            - 0 success
+ *            - 2 group or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 num is invalid
+ * @note      all handles must be initialized before
+ */
+uint8_t max6675_group_init(max6675_group_t *group, max6675_handle_t **handle, uint16_t num)
+{
+    uint16_t i;
+    
+    if ((group == NULL) || (handle == NULL))        /* check group and handle */
+    {
+        return 2;                                   /* return error */
+    }
+    if (num == 0)                                   /* check num */
+    {
+        return 4;                                   /* return error */
+    }
+    for (i = 0; i < num; i++)                       /* check all handles */
+    {
+        if (handle[i] == NULL)                      /* check handle */
+        {
+            return 2;                               /* return error */
+        }
+        if (handle[i]->inited != 1)                 /* check handle initialization */
+        {
+            return 3;                               /* return error */
+        }
+    }
+    
+    group->handle = handle;                         /* set the handle list */
+    group->num = num;                               /* set the handle number */
+    
+    return 0;                                       /* success return 0 */
+}
+
+#if (MAX6675_FLOAT_SUPPORT == 1)
+/**
+ * @brief      read the temperature of all devices in a group
+ * @param[in]  *group pointer to a max6675 group structure
+ * @param[out] *raw pointer to a raw data list with group num items
+ * @param[out] *temp pointer to a temp list with group num items
+ * @param[out] *status pointer to a status list with group num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 group, raw, temp or status is NULL
+ *             - 3 handle is not initialized
+ * @note       status item is the max6675_read status code of each device and the raw and temp
+ *             items are only valid when the status item is 0, 1 is returned when the spi read
+ *             of at least one device failed, when spi_read_many_cmd is linked and no device is
+ *             busy or has a cached frame all frames are read in one bus operation, else every
+ *             device is read with its own cache and busy state
+ */
+uint8_t max6675_read_many(max6675_group_t *group, uint16_t *raw, float *temp, uint8_t *status)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    if (temp == NULL)                                        /* check temp */
+    {
+        return 2;                                            /* return error */
+    }
+    res = a_max6675_read_many(group, raw, status);           /* read all raw data */
+    if ((res != 0) && (res != 1))                            /* check result */
+    {
+        return res;                                          /* return error */
+    }
+    for (i = 0; i < group->num; i++)                         /* convert all data */
+    {
+        temp[i] = (float)(raw[i]) * 0.25f;                   /* convert data */
+    }
+    
+    return res;                                              /* return the result */
+}
+#endif
+
+/**
+ * @brief      read the temperature of all devices in a group in fixed point
+ * @param[in]  *group pointer to a max6675 group structure
+ * @param[out] *raw pointer to a raw data list in 0.25C with group num items
+ * @param[out] *temp pointer to a temp list in 0.01C with group num items
+ * @param[out] *status pointer to a status list with group num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 group, raw, temp or status is NULL
+ *             - 3 handle is not initialized
+ * @note       status item is the max6675_read_fixed status code of each device and the raw and
+ *             temp items are only valid when the status item is 0, 1 is returned when the spi
+ *             read of at least one device failed, when spi_read_many_cmd is linked and no device
+ *             is busy or has a cached frame all frames are read in one bus operation, else every
+ *             device is read with its own cache and busy state
+ */
+uint8_t max6675_read_many_fixed(max6675_group_t *group, uint16_t *raw, int32_t *temp, uint8_t *status)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    if (temp == NULL)                                        /* check temp */
+    {
+        return 2;                                            /* return error */
+    }
+    res = a_max6675_read_many(group, raw, status);           /* read all raw data */
+    if ((res != 0) && (res != 1))                            /* check result */
+    {
+        return res;                                          /* return error */
+    }
+    for (i = 0; i < group->num; i++)                         /* convert all data */
+    {
+        temp[i] = (int32_t)(raw[i]) * 25;                    /* convert data */
+    }
+    
+    return res;                                              /* return the result */
+}
+
+/**
+ * @brief     enable or disable the sample cache
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ms is null
+ * @note      every frame read aborts the conversion in progress, so when the cache is enabled
+ *            max6675_read returns the last frame without any spi transaction until a new
+ *            conversion has finished
+ */
+uint8_t max6675_set_cache(max6675_handle_t *handle, max6675_bool_t enable)
+{
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((enable == MAX6675_BOOL_TRUE) && (handle->get_tick_ms == NULL))        /* check get_tick_ms */
+    {
+        a_max6675_print(handle, MAX6675_LOG_MSG_GET_TICK_MS_NULL, 0);          /* get_tick_ms is null */
+        
+        return 4;                                                              /* return error */
+    }
+    
+    handle->cache_enable = (uint8_t)enable;                                    /* set the cache */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the sample cache status
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_cache(max6675_handle_t *handle, max6675_bool_t *enable)
+{
+    if (handle == NULL)                                         /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    if (handle->inited != 1)                                    /* check handle initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    *enable = (max6675_bool_t)(handle->cache_enable);           /* get the cache */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the chip register
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 read is busy
+ * @note       none
+ */
+uint8_t max6675_get_reg(max6675_handle_t *handle, uint16_t *data)
+{
+    if (handle == NULL)                            /* check handle */
+    {
+        return 2;                                  /* return error */
+    }
+    if (handle->inited != 1)                       /* check handle initialization */
+    {
+        return 3;                                  /* return error */
+    }
+    if (handle->async_busy != 0)                   /* check the async read */
+    {
+        return 4;                                  /* return error */
+    }
+    
+    return a_max6675_spi_read(handle, data);       /* read data */
+}
+
+/**
+ * @brief      decode a frame
+ * @param[in]  frame chip register frame
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 raw is NULL
+ *             - 4 thermocouple input is open
+ *             - 6 frame is corrupt
+ * @note       this function has no side effect and needs no handle
+ */
+uint8_t max6675_decode_frame(uint16_t frame, uint16_t *raw)
+{
+    if (raw == NULL)                              /* check raw */
+    {
+        return 2;                                 /* return error */
+    }
+    if (a_max6675_frame_corrupt(frame) != 0)      /* check the frame */
+    {
+        return 6;                                 /* return error */
+    }
+    if ((frame & (1 << 2)) != 0)                  /* check the error */
+    {
+        return 4;                                 /* return error */
+    }
+    *raw = frame >> 3;                            /* get the raw data */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief     set the read retry times
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] times retry times, 0 disables the retry
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a spi failure or a corrupt frame is read again after the cs high time,
+ *            the async and the group batch reads never retry
+ */
+uint8_t max6675_set_retry(max6675_handle_t *handle, uint8_t times)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    handle->retry = times;              /* set the retry times */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      get the read retry times
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_retry(max6675_handle_t *handle, uint8_t *times)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    *times = handle->retry;             /* get the retry times */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the stuck low check
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the chip clamps a sub-zero reading to the 0x0000 frame, so it is a valid 0C
+ *            reading by default, enable the check only for probes that never go down to 0C
+ *            and then 0x0000 is reported as a corrupt frame of a stuck low miso line
+ */
+uint8_t max6675_set_stuck_low(max6675_handle_t *handle, max6675_bool_t enable)
+{
+    if (handle == NULL)                          /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    if (handle->inited != 1)                     /* check handle initialization */
+    {
+        return 3;                                /* return error */
+    }
+    
+    handle->stuck_low = (uint8_t)enable;         /* set the check */
+    handle->cache_valid = 0;                     /* invalidate the cache */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the stuck low check status
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_stuck_low(max6675_handle_t *handle, max6675_bool_t *enable)
+{
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    *enable = (max6675_bool_t)(handle->stuck_low);        /* get the check */
+    
+    return 0;                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the fault print mode
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] mode print mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t max6675_set_print_mode(max6675_handle_t *handle, max6675_print_mode_t mode)
+{
+    if (handle == NULL)                          /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    if (handle->inited != 1)                     /* check handle initialization */
+    {
+        return 3;                                /* return error */
+    }
+    
+    handle->print_mode = (uint8_t)mode;          /* set the mode */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the fault print mode
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *mode pointer to a print mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_print_mode(max6675_handle_t *handle, max6675_print_mode_t *mode)
+{
+    if (handle == NULL)                                         /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    if (handle->inited != 1)                                    /* check handle initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    *mode = (max6675_print_mode_t)(handle->print_mode);         /* get the mode */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *stats pointer to a max6675 stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       only the frames read from the bus are counted
+ */
+uint8_t max6675_get_stats(max6675_handle_t *handle, max6675_stats_t *stats)
+{
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    
+    memcpy(stats, &handle->stats, sizeof(max6675_stats_t));          /* copy the statistics */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     clear the statistics
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t max6675_clear_stats(max6675_handle_t *handle)
+{
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    
+    memset(&handle->stats, 0, sizeof(max6675_stats_t));             /* clear the statistics */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     initialize a sample ring
+ * @param[in] *ring pointer to a max6675 ring structure
+ * @param[in] *buf pointer to a sample storage with MAX6675_RING_SIZE items
+ * @return    status code
+ *            - 0 success
+ *            - 2 ring or buf is NULL
+ * @note      none
+ */
+uint8_t max6675_ring_init(max6675_ring_t *ring, max6675_sample_t *buf)
+{
+    if ((ring == NULL) || (buf == NULL))        /* check ring and buf */
+    {
+        return 2;                               /* return error */
+    }
+    
+    ring->buf = buf;                            /* set the storage */
+    ring->head = 0;                             /* init 0 */
+    ring->tail = 0;                             /* init 0 */
+    ring->overrun = 0;                          /* init 0 */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief     attach a sample ring to the handle
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *ring pointer to a max6675 ring structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      every frame read from the bus by the read functions is pushed into the attached ring,
+ *            the read functions are the only producer
+ */
+uint8_t max6675_set_ring(max6675_handle_t *handle, max6675_ring_t *ring)
+{
+    if (handle == NULL)                  /* check handle */
+    {
+        return 2;                        /* return error */
+    }
+    if (handle->inited != 1)             /* check handle initialization */
+    {
+        return 3;                        /* return error */
+    }
+    
+    handle->ring = ring;                 /* set the ring */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief     push a sample into the ring
+ * @param[in] *ring pointer to a max6675 ring structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ *            - 2 ring or sample is NULL
+ * @note      only one producer is allowed and a full ring drops the sample and counts an overrun
+ */
+uint8_t max6675_ring_push(max6675_ring_t *ring, const max6675_sample_t *sample)
+{
+    uint32_t head;
+    
+    if ((ring == NULL) || (sample == NULL))                                /* check ring and sample */
+    {
+        return 2;                                                          /* return error */
+    }
+    
+    head = ring->head;                                                     /* get the head */
+    if ((head - ring->tail) >= MAX6675_RING_SIZE)                          /* check full */
+    {
+        ring->overrun++;                                                   /* count the overrun */
+        
+        return 1;                                                          /* return error */
+    }
+    ring->buf[head & (MAX6675_RING_SIZE - 1)] = *sample;                   /* copy the sample */
+    MAX6675_RING_MEMORY_BARRIER();                                         /* publish the sample before the head */
+    ring->head = head + 1;                                                 /* update the head */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      pop a sample from the ring
+ * @param[in]  *ring pointer to a max6675 ring structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 ring is empty
+ *             - 2 ring or sample is NULL
+ * @note       only one consumer is allowed
+ */
+uint8_t max6675_ring_pop(max6675_ring_t *ring, max6675_sample_t *sample)
+{
+    uint32_t num;
+    
+    if (max6675_ring_pop_many(ring, sample, 1, &num) != 0)        /* pop one sample */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (num == 0)                                                 /* check empty */
+    {
+        return 1;                                                 /* return error */
+    }
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      pop many samples from the ring
+ * @param[in]  *ring pointer to a max6675 ring structure
+ * @param[out] *sample pointer to a sample list
+ * @param[in]  len sample list length
+ * @param[out] *num pointer to a popped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ring, sample or num is NULL
+ * @note       only one consumer is allowed
+ */
+uint8_t max6675_ring_pop_many(max6675_ring_t *ring, max6675_sample_t *sample, uint32_t len, uint32_t *num)
+{
+    uint32_t i;
+    uint32_t n;
+    uint32_t tail;
+    
+    if ((ring == NULL) || (sample == NULL) || (num == NULL))                  /* check ring, sample and num */
+    {
+        return 2;                                                             /* return error */
+    }
+    
+    tail = ring->tail;                                                        /* get the tail */
+    n = ring->head - tail;                                                    /* get the filled number */
+    MAX6675_RING_MEMORY_BARRIER();                                            /* read the head before the samples */
+    if (n > len)                                                              /* check the list length */
+    {
+        n = len;                                                              /* limit the number */
+    }
+    for (i = 0; i < n; i++)                                                   /* copy all samples */
+    {
+        sample[i] = ring->buf[(tail + i) & (MAX6675_RING_SIZE - 1)];          /* copy the sample */
+    }
+    MAX6675_RING_MEMORY_BARRIER();                                            /* finish the copy before the tail */
+    ring->tail = tail + n;                                                    /* update the tail */
+    *num = n;                                                                 /* set the number */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the ring overrun counter
+ * @param[in]  *ring pointer to a max6675 ring structure
+ * @param[out] *overrun pointer to an overrun counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ring or overrun is NULL
+ * @note       none
+ */
+uint8_t max6675_ring_get_overrun(max6675_ring_t *ring, uint32_t *overrun)
+{
+    if ((ring == NULL) || (overrun == NULL))        /* check ring and overrun */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    *overrun = ring->overrun;                       /* get the overrun */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief     initialize a sampling period
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *period pointer to a max6675 period structure
+ * @param[in] period_ms sampling period in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or period is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ms is null
+ *            - 5 period_ms is 0
+ * @note      the first deadline is one period from now
+ */
+uint8_t max6675_period_init(max6675_handle_t *handle, max6675_period_t *period, uint32_t period_ms)
+{
+    if ((handle == NULL) || (period == NULL))                             /* check handle and period */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if (handle->get_tick_ms == NULL)                                      /* check get_tick_ms */
+    {
+        a_max6675_print(handle, MAX6675_LOG_MSG_GET_TICK_MS_NULL, 0);     /* get_tick_ms is null */
+        
+        return 4;                                                         /* return error */
+    }
+    if (period_ms == 0)                                                   /* check period_ms */
+    {
+        return 5;                                                         /* return error */
+    }
+    
+    period->period_ms = period_ms;                                        /* set the period */
+    period->deadline = handle->get_tick_ms() + period_ms;                 /* set the first deadline */
+    period->overrun = 0;                                                  /* clear the overrun */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     wait for the next sampling deadline
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *period pointer to a max6675 period structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or period is NULL
+ *            - 3 handle is not initialized
+ * @note      the deadlines are absolute, so the read time and the wake up latency do not add
+ *            up over the samples, deadlines that have already passed by a whole period are
+ *            skipped and counted as overruns
+ */
+uint8_t max6675_period_wait(max6675_handle_t *handle, max6675_period_t *period)
+{
+    uint32_t now;
+    uint32_t missed;
+    int32_t late;
+    
+    if ((handle == NULL) || (period == NULL))                                 /* check handle and period */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    
+    now = handle->get_tick_ms();                                              /* get the tick */
+    late = (int32_t)(now - period->deadline);                                 /* get the lateness */
+    if (late >= (int32_t)period->period_ms)                                   /* whole periods are missed */
+    {
+        missed = (uint32_t)late / period->period_ms;                          /* missed periods */
+        period->overrun += missed;                                            /* count the overrun */
+        period->deadline += missed * period->period_ms;                       /* keep the phase */
+    }
+    if ((int32_t)(period->deadline - now) > 0)                                /* the deadline is ahead */
+    {
+        if (handle->wait_until_ms != NULL)                                    /* check wait_until_ms */
+        {
+            handle->wait_until_ms(period->deadline);                          /* sleep until the deadline */
+        }
+        else
+        {
+            handle->delay_ms(period->deadline - now);                         /* delay the rest */
+        }
+    }
+    period->deadline += period->period_ms;                                    /* next deadline */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the period overrun counter
+ * @param[in]  *period pointer to a max6675 period structure
+ * @param[out] *overrun pointer to an overrun counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 period or overrun is NULL
+ * @note       none
+ */
+uint8_t max6675_period_get_overrun(max6675_period_t *period, uint32_t *overrun)
+{
+    if ((period == NULL) || (overrun == NULL))        /* check period and overrun */
+    {
+        return 2;                                     /* return error */
+    }
+    
+    *overrun = period->overrun;                       /* get the overrun */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief     initialize a binary log
+ * @param[in] *log pointer to a max6675 log structure
+ * @param[in] *buf pointer to a record storage
+ * @param[in] size record storage length
+ * @return    status code
+ *            - 0 success
+ *            - 2 log or buf is NULL
+ *            - 4 size is invalid
+ * @note      none
+ */
+uint8_t max6675_log_init(max6675_log_t *log, max6675_log_record_t *buf, uint32_t size)
+{
+    if ((log == NULL) || (buf == NULL))        /* check log and buf */
+    {
+        return 2;                              /* return error */
+    }
+    if (size == 0)                             /* check size */
+    {
+        return 4;                              /* return error */
+    }
+    
+    log->buf = buf;                            /* set the storage */
+    log->size = size;                          /* set the size */
+    log->count = 0;                            /* no record */
+    log->dropped = 0;                          /* no dropped record */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     clear a binary log
+ * @param[in] *log pointer to a max6675 log structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 log is NULL
+ * @note      the dropped counter is cleared too
+ */
+uint8_t max6675_log_clear(max6675_log_t *log)
+{
+    if (log == NULL)             /* check log */
+    {
+        return 2;                /* return error */
+    }
+    
+    log->count = 0;              /* no record */
+    log->dropped = 0;            /* no dropped record */
+    
+    return 0;                    /* success return 0 */
+}
+
+/**
+ * @brief     attach a binary log to the handle
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *log pointer to a max6675 log structure, NULL to detach
+ * @param[in] id handle id written into the records
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it can be called before max6675_init to record the init diagnostics,
+ *            the records are only written when MAX6675_LOG_BINARY is 1,
+ *            many handles can share one log when they are used from one thread
+ */
+uint8_t max6675_set_log(max6675_handle_t *handle, max6675_log_t *log, uint8_t id)
+{
+    if (handle == NULL)           /* check handle */
+    {
+        return 2;                 /* return error */
+    }
+    
+    handle->log = log;            /* set the log */
+    handle->log_id = id;          /* set the id */
+    
+    return 0;                     /* success return 0 */
+}
+
+/**
+ * @brief     get the message string of a log record
+ * @param[in] msg message id
+ * @return    pointer to the message string, NULL if the id is invalid
+ * @note      none
+ */
+const char *max6675_log_message(uint8_t msg)
+{
+    if (msg >= (uint8_t)MAX6675_LOG_MSG_MAX)        /* check the id */
+    {
+        return NULL;                                /* return NULL */
+    }
+    
+    return gsc_max6675_log_message[msg];            /* return the string */
 }
 
 /**
@@ -263,11 +1608,13 @@ uint8_t max6675_info(max6675_info_t *info)
     strncpy(info->chip_name, CHIP_NAME, 32);                        /* copy chip name */
     strncpy(info->manufacturer_name, MANUFACTURER_NAME, 32);        /* copy manufacturer name */
     strncpy(info->interface, "SPI", 8);                             /* copy interface name */
+#if (MAX6675_FLOAT_SUPPORT == 1)
     info->supply_voltage_min_v = SUPPLY_VOLTAGE_MIN;                /* set minimal supply voltage */
     info->supply_voltage_max_v = SUPPLY_VOLTAGE_MAX;                /* set maximum supply voltage */
     info->max_current_ma = MAX_CURRENT;                             /* set maximum current */
     info->temperature_max = TEMPERATURE_MAX;                        /* set minimal temperature */
     info->temperature_min = TEMPERATURE_MIN;                        /* set maximum temperature */
+#endif
     info->driver_version = DRIVER_VERSION;                          /* set driver version */
     
     return 0;                                                       /* success return 0 */
@@ -45,6 +45,46 @@
 extern "C"{
 #endif
 
+/**
+ * @brief float support definition
+ * @note  define 0 to remove float from the driver on the fpu-less targets
+ */
+#ifndef MAX6675_FLOAT_SUPPORT
+    #define MAX6675_FLOAT_SUPPORT        1        /**< float support */
+#endif
+
+/**
+ * @brief sample ring size definition
+ * @note  the size must be a power of 2
+ */
+#ifndef MAX6675_RING_SIZE
+    #define MAX6675_RING_SIZE        16           /**< 16 samples */
+#endif
+#if ((MAX6675_RING_SIZE == 0) || ((MAX6675_RING_SIZE & (MAX6675_RING_SIZE - 1)) != 0))
+    #error "MAX6675_RING_SIZE must be a power of 2"
+#endif
+
+/**
+ * @brief sample ring memory barrier definition
+ * @note  define it for the compilers without the gcc builtins
+ */
+#ifndef MAX6675_RING_MEMORY_BARRIER
+    #if defined(__GNUC__)
+        #define MAX6675_RING_MEMORY_BARRIER()        __sync_synchronize()        /**< full memory barrier */
+    #else
+        #define MAX6675_RING_MEMORY_BARRIER()                                    /**< no memory barrier */
+    #endif
+#endif
+
+/**
+ * @brief binary log definition
+ * @note  define 1 to record the diagnostics as binary events in the attached log instead of
+ *        formatting them with debug_print
+ */
+#ifndef MAX6675_LOG_BINARY
+    #define MAX6675_LOG_BINARY        0        /**< text diagnostics */
+#endif
+
 /**
  * @defgroup max6675_driver max6675 driver function
  * @brief    max6675 driver modules
@@ -56,19 +96,158 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief max6675 bool enumeration definition
+ */
+typedef enum
+{
+    MAX6675_BOOL_FALSE = 0x00,        /**< disable function */
+    MAX6675_BOOL_TRUE  = 0x01,        /**< enable function */
+} max6675_bool_t;
+
+/**
+ * @brief max6675 print mode enumeration definition
+ */
+typedef enum
+{
+    MAX6675_PRINT_MODE_ALL        = 0x00,        /**< print every fault */
+    MAX6675_PRINT_MODE_TRANSITION = 0x01,        /**< print the fault state transitions */
+    MAX6675_PRINT_MODE_NONE       = 0x02,        /**< never print the faults */
+} max6675_print_mode_t;
+
+/**
+ * @brief max6675 stats structure definition
+ */
+typedef struct max6675_stats_s
+{
+    uint32_t spi_fail;                 /**< spi failure counter */
+    uint32_t open;                     /**< open thermocouple counter */
+    uint32_t corrupt;                  /**< corrupt frame counter */
+    uint32_t retry;                    /**< read retry counter */
+    uint32_t consecutive_fault;        /**< consecutive fault counter */
+    uint32_t last_fault_tick;          /**< tick of the last fault in ms */
+} max6675_stats_t;
+
+/**
+ * @brief max6675 log message enumeration definition
+ */
+typedef enum
+{
+    MAX6675_LOG_MSG_SPI_INIT_NULL      = 0x00,        /**< spi_init is null */
+    MAX6675_LOG_MSG_SPI_DEINIT_NULL    = 0x01,        /**< spi_deinit is null */
+    MAX6675_LOG_MSG_SPI_READ_CMD_NULL  = 0x02,        /**< spi_read_cmd is null */
+    MAX6675_LOG_MSG_DELAY_MS_NULL      = 0x03,        /**< delay_ms is null */
+    MAX6675_LOG_MSG_GET_TICK_MS_NULL   = 0x04,        /**< get_tick_ms is null */
+    MAX6675_LOG_MSG_SPI_INIT_FAILED    = 0x05,        /**< spi init failed */
+    MAX6675_LOG_MSG_SPI_DEINIT_FAILED  = 0x06,        /**< spi deinit failed */
+    MAX6675_LOG_MSG_READ_FAILED        = 0x07,        /**< read data failed */
+    MAX6675_LOG_MSG_OPEN               = 0x08,        /**< thermocouple input is open */
+    MAX6675_LOG_MSG_FAULT_CLEARED      = 0x09,        /**< fault is cleared */
+    MAX6675_LOG_MSG_CORRUPT            = 0x0A,        /**< frame is corrupt */
+    MAX6675_LOG_MSG_MAX                = 0x0B,        /**< message number */
+} max6675_log_msg_t;
+
+/**
+ * @brief max6675 log record structure definition
+ */
+typedef struct max6675_log_record_s
+{
+    uint32_t tick;        /**< tick of the event in ms */
+    uint16_t arg;         /**< event argument */
+    uint8_t msg;          /**< message id */
+    uint8_t id;           /**< handle id */
+} max6675_log_record_t;
+
+/**
+ * @brief max6675 log structure definition
+ */
+typedef struct max6675_log_s
+{
+    max6675_log_record_t *buf;        /**< record storage */
+    uint32_t size;                    /**< record storage length */
+    uint32_t count;                   /**< recorded number */
+    uint32_t dropped;                 /**< dropped record counter */
+} max6675_log_t;
+
+/**
+ * @brief max6675 sample structure definition
+ */
+typedef struct max6675_sample_s
+{
+    uint32_t tick;          /**< tick of the frame in ms */
+    uint16_t frame;         /**< chip register frame */
+    uint8_t status;         /**< read status code */
+} max6675_sample_t;
+
+/**
+ * @brief max6675 sample ring structure definition
+ */
+typedef struct max6675_ring_s
+{
+    max6675_sample_t *buf;            /**< sample storage with MAX6675_RING_SIZE items */
+    volatile uint32_t head;           /**< producer index */
+    volatile uint32_t tail;           /**< consumer index */
+    volatile uint32_t overrun;        /**< dropped sample counter */
+} max6675_ring_t;
+
+/**
+ * @brief max6675 period structure definition
+ */
+typedef struct max6675_period_s
+{
+    uint32_t period_ms;        /**< sampling period */
+    uint32_t deadline;         /**< tick of the next sample */
+    uint32_t overrun;          /**< skipped periods */
+} max6675_period_t;
+
 /**
  * @brief max6675 handle structure definition
  */
 typedef struct max6675_handle_s
 {
-    uint8_t (*spi_init)(void);                                  /**< point to a spi_init function address */
-    uint8_t (*spi_deinit)(void);                                /**< point to a spi_deinit function address */
-    uint8_t (*spi_read_cmd)(uint8_t *buf, uint16_t len);        /**< point to a spi_read_cmd function address */
+    uint8_t (*spi_init)(void *ctx);                                        /**< point to a spi_init function address */
+    uint8_t (*spi_deinit)(void *ctx);                                      /**< point to a spi_deinit function address */
+    uint8_t (*spi_read_cmd)(void *ctx, uint8_t *buf, uint16_t len);        /**< point to a spi_read_cmd function address */
+    uint8_t (*spi_read_cmd_async)(void *ctx, uint8_t *buf, uint16_t len,
+                                  void (*complete)(uint8_t res, void *param),
+                                  void *param);                            /**< point to a spi_read_cmd_async function address */
+    void *ctx;                                                             /**< user context passed to the spi functions */
     void (*delay_ms)(uint32_t ms);                              /**< point to a delay_ms function address */
+    uint32_t (*get_tick_ms)(void);                              /**< point to a get_tick_ms function address */
+    void (*wait_until_ms)(uint32_t tick);                       /**< point to a wait_until_ms function address */
     void (*debug_print)(const char *const fmt, ...);            /**< point to a debug_print function address */
     uint8_t inited;                                             /**< inited flag */
+    uint8_t cache_enable;                                       /**< cache enable flag */
+    uint8_t cache_valid;                                        /**< cache valid flag */
+    uint16_t cache_data;                                        /**< cached frame */
+    uint32_t cache_tick;                                        /**< tick of the last frame */
+    max6675_ring_t *ring;                                       /**< attached sample ring */
+    max6675_stats_t stats;                                      /**< statistics */
+    uint8_t fault_state;                                        /**< last fault status */
+    uint8_t print_mode;                                         /**< fault print mode */
+    max6675_log_t *log;                                         /**< attached binary log */
+    uint8_t log_id;                                             /**< handle id in the log */
+    void (*async_callback)(uint8_t res, uint16_t raw,
+                           int32_t temp, void *ctx);            /**< async read callback */
+    void *async_ctx;                                            /**< async read user context */
+    uint8_t async_buf[2];                                       /**< async read buffer */
+    volatile uint8_t async_busy;                                /**< async read busy flag */
+    uint8_t retry;                                              /**< read retry times */
+    uint8_t stuck_low;                                          /**< stuck low miso check flag */
 } max6675_handle_t;
 
+/**
+ * @brief max6675 group structure definition
+ */
+typedef struct max6675_group_s
+{
+    uint8_t (*spi_read_many_cmd)(void *ctx, uint8_t *buf,
+                                 uint16_t len, uint16_t num);                      /**< point to a spi_read_many_cmd function address */
+    void *ctx;                                                                     /**< user context passed to spi_read_many_cmd */
+    max6675_handle_t **handle;                                                     /**< handle list */
+    uint16_t num;                                                                  /**< handle number */
+} max6675_group_t;
+
 /**
  * @brief max6675 information structure definition
  */
@@ -77,11 +256,13 @@ typedef struct max6675_info_s
     char chip_name[32];                /**< chip name */
     char manufacturer_name[32];        /**< manufacturer name */
     char interface[8];                 /**< chip interface name */
+#if (MAX6675_FLOAT_SUPPORT == 1)
     float supply_voltage_min_v;        /**< chip min supply voltage */
     float supply_voltage_max_v;        /**< chip max supply voltage */
     float max_current_ma;              /**< chip max current */
     float temperature_min;             /**< chip min operating temperature */
     float temperature_max;             /**< chip max operating temperature */
+#endif
     uint32_t driver_version;           /**< driver version */
 } max6675_info_t;
 
@@ -128,6 +309,14 @@ typedef struct max6675_info_s
  */
 #define DRIVER_MAX6675_LINK_SPI_READ_COMMAND(HANDLE, FUC)        (HANDLE)->spi_read_cmd = FUC
 
+/**
+ * @brief     link the user context
+ * @param[in] HANDLE pointer to a max6675 handle structure
+ * @param[in] CTX pointer to a user context
+ * @note      the context is passed to every spi function of the handle, NULL by default
+ */
+#define DRIVER_MAX6675_LINK_CONTEXT(HANDLE, CTX)                 (HANDLE)->ctx = CTX
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to a max6675 handle structure
@@ -136,6 +325,31 @@ typedef struct max6675_info_s
  */
 #define DRIVER_MAX6675_LINK_DELAY_MS(HANDLE, FUC)                (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link spi_read_cmd_async function
+ * @param[in] HANDLE pointer to a max6675 handle structure
+ * @param[in] FUC pointer to a spi_read_cmd_async function address
+ * @note      this function is optional and max6675_read_async falls back to spi_read_cmd without it
+ */
+#define DRIVER_MAX6675_LINK_SPI_READ_COMMAND_ASYNC(HANDLE, FUC)  (HANDLE)->spi_read_cmd_async = FUC
+
+/**
+ * @brief     link get_tick_ms function
+ * @param[in] HANDLE pointer to a max6675 handle structure
+ * @param[in] FUC pointer to a get_tick_ms function address
+ * @note      the tick must be monotonic and is only needed by the cache mode
+ */
+#define DRIVER_MAX6675_LINK_GET_TICK_MS(HANDLE, FUC)             (HANDLE)->get_tick_ms = FUC
+
+/**
+ * @brief     link wait_until_ms function
+ * @param[in] HANDLE pointer to a max6675 handle structure
+ * @param[in] FUC pointer to a wait_until_ms function address
+ * @note      this function is optional and sleeps until an absolute get_tick_ms tick,
+ *            max6675_period_wait falls back to delay_ms without it
+ */
+#define DRIVER_MAX6675_LINK_WAIT_UNTIL_MS(HANDLE, FUC)           (HANDLE)->wait_until_ms = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to a max6675 handle structure
@@ -144,6 +358,31 @@ typedef struct max6675_info_s
  */
 #define DRIVER_MAX6675_LINK_DEBUG_PRINT(HANDLE, FUC)             (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     initialize max6675_group_t structure
+ * @param[in] GROUP pointer to a max6675 group structure
+ * @param[in] STRUCTURE max6675_group_t
+ * @note      none
+ */
+#define DRIVER_MAX6675_GROUP_LINK_INIT(GROUP, STRUCTURE)         memset(GROUP, 0, sizeof(STRUCTURE))
+
+/**
+ * @brief     link spi_read_many_cmd function
+ * @param[in] GROUP pointer to a max6675 group structure
+ * @param[in] FUC pointer to a spi_read_many_cmd function address
+ * @note      this function is optional, frame i must be read from the i-th device of the group
+ *            and a bus that can not select the devices one by one must fail
+ */
+#define DRIVER_MAX6675_GROUP_LINK_SPI_READ_MANY_COMMAND(GROUP, FUC)        (GROUP)->spi_read_many_cmd = FUC
+
+/**
+ * @brief     link the group user context
+ * @param[in] GROUP pointer to a max6675 group structure
+ * @param[in] CTX pointer to a user context
+ * @note      the context is passed to spi_read_many_cmd, NULL by default
+ */
+#define DRIVER_MAX6675_GROUP_LINK_CONTEXT(GROUP, CTX)                      (GROUP)->ctx = CTX
+
 /**
  * @}
  */
@@ -185,10 +424,12 @@ uint8_t max6675_init(max6675_handle_t *handle);
  *            - 1 deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 read is busy
+ * @note      an async read in flight must complete before the spi is deinitialized
  */
 uint8_t max6675_deinit(max6675_handle_t *handle);
 
+#if (MAX6675_FLOAT_SUPPORT == 1)
 /**
  * @brief      read the temperature
  * @param[in]  *handle pointer to a max6675 handle structure
@@ -200,9 +441,228 @@ uint8_t max6675_deinit(max6675_handle_t *handle);
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
  * @note       none
  */
 uint8_t max6675_read(max6675_handle_t *handle,uint16_t *raw, float *temp);
+#endif
+
+/**
+ * @brief      read the temperature in fixed point
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *raw pointer to a raw data buffer in 0.25C
+ * @param[out] *temp pointer to a temp buffer in 0.01C
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
+ * @note       none
+ */
+uint8_t max6675_read_fixed(max6675_handle_t *handle, uint16_t *raw, int32_t *temp);
+
+/**
+ * @brief     start an asynchronous temperature read
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *ctx pointer to a user context passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle or callback is NULL
+ *            - 3 handle is not initialized
+ *            - 4 read is busy
+ * @note      the callback gets the max6675_read_fixed status code, the raw data in 0.25C and
+ *            the temperature in 0.01C, it runs from the spi_read_cmd_async completion which
+ *            may be an interrupt, a cached frame or a handle without spi_read_cmd_async
+ *            completes synchronously before this function returns
+ */
+uint8_t max6675_read_async(max6675_handle_t *handle,
+                           void (*callback)(uint8_t res, uint16_t raw, int32_t temp, void *ctx),
+                           void *ctx);
+
+/**
+ * @brief     initialize a device group
+ * @param[in] *group pointer to a max6675 group structure
+ * @param[in] **handle pointer to a handle list
+ * @param[in] num handle number
+ * @return    status code
+ *            - 0 success
+ *            - 2 group or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 num is invalid
+ * @note      all handles must be initialized before
+ */
+uint8_t max6675_group_init(max6675_group_t *group, max6675_handle_t **handle, uint16_t num);
+
+#if (MAX6675_FLOAT_SUPPORT == 1)
+/**
+ * @brief      read the temperature of all devices in a group
+ * @param[in]  *group pointer to a max6675 group structure
+ * @param[out] *raw pointer to a raw data list with group num items
+ * @param[out] *temp pointer to a temp list with group num items
+ * @param[out] *status pointer to a status list with group num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 group, raw, temp or status is NULL
+ *             - 3 handle is not initialized
+ * @note       status item is the max6675_read status code of each device and the raw and temp
+ *             items are 0 when the status item is not 0, 1 is returned when the spi read
+ *             of at least one device failed, when spi_read_many_cmd is linked and no device is
+ *             busy or has a cached frame all frames are read in one bus operation, else every
+ *             device is read with its own cache and busy state
+ */
+uint8_t max6675_read_many(max6675_group_t *group, uint16_t *raw, float *temp, uint8_t *status);
+#endif
+
+/**
+ * @brief      read the temperature of all devices in a group in fixed point
+ * @param[in]  *group pointer to a max6675 group structure
+ * @param[out] *raw pointer to a raw data list in 0.25C with group num items
+ * @param[out] *temp pointer to a temp list in 0.01C with group num items
+ * @param[out] *status pointer to a status list with group num items
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 group, raw, temp or status is NULL
+ *             - 3 handle is not initialized
+ * @note       status item is the max6675_read_fixed status code of each device and the raw and
+ *             temp items are 0 when the status item is not 0, 1 is returned when the spi
+ *             read of at least one device failed, when spi_read_many_cmd is linked and no device
+ *             is busy or has a cached frame all frames are read in one bus operation, else every
+ *             device is read with its own cache and busy state
+ */
+uint8_t max6675_read_many_fixed(max6675_group_t *group, uint16_t *raw, int32_t *temp, uint8_t *status);
+
+/**
+ * @brief     enable or disable the sample cache
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ms is null
+ * @note      every frame read aborts the conversion in progress, so when the cache is enabled
+ *            max6675_read returns the last frame without any spi transaction until a new
+ *            conversion has finished
+ */
+uint8_t max6675_set_cache(max6675_handle_t *handle, max6675_bool_t enable);
+
+/**
+ * @brief      get the sample cache status
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_cache(max6675_handle_t *handle, max6675_bool_t *enable);
+
+/**
+ * @brief     set the read retry times
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] times retry times, 0 disables the retry
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a spi failure or a corrupt frame is read again after the cs high time,
+ *            the async and the group batch reads never retry
+ */
+uint8_t max6675_set_retry(max6675_handle_t *handle, uint8_t times);
+
+/**
+ * @brief      get the read retry times
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_retry(max6675_handle_t *handle, uint8_t *times);
+
+/**
+ * @brief     enable or disable the stuck low check
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the chip clamps a sub-zero reading to the 0x0000 frame, so it is a valid 0C
+ *            reading by default, enable the check only for probes that never go down to 0C
+ *            and then 0x0000 is reported as a corrupt frame of a stuck low miso line
+ */
+uint8_t max6675_set_stuck_low(max6675_handle_t *handle, max6675_bool_t enable);
+
+/**
+ * @brief      get the stuck low check status
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_stuck_low(max6675_handle_t *handle, max6675_bool_t *enable);
+
+/**
+ * @brief     set the fault print mode
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] mode print mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t max6675_set_print_mode(max6675_handle_t *handle, max6675_print_mode_t mode);
+
+/**
+ * @brief      get the fault print mode
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *mode pointer to a print mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t max6675_get_print_mode(max6675_handle_t *handle, max6675_print_mode_t *mode);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[out] *stats pointer to a max6675 stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       only the frames read from the bus are counted
+ */
+uint8_t max6675_get_stats(max6675_handle_t *handle, max6675_stats_t *stats);
+
+/**
+ * @brief     clear the statistics
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t max6675_clear_stats(max6675_handle_t *handle);
 
 /**
  * @}
@@ -224,10 +684,214 @@ uint8_t max6675_read(max6675_handle_t *handle,uint16_t *raw, float *temp);
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 read is busy
  * @note       none
  */
 uint8_t max6675_get_reg(max6675_handle_t *handle, uint16_t *data);
 
+/**
+ * @brief      decode a frame
+ * @param[in]  frame chip register frame
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 raw is NULL
+ *             - 4 thermocouple input is open
+ *             - 6 frame is corrupt
+ * @note       this function has no side effect and needs no handle
+ */
+uint8_t max6675_decode_frame(uint16_t frame, uint16_t *raw);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup max6675_ring_driver max6675 ring driver function
+ * @brief    max6675 ring driver modules
+ * @ingroup  max6675_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize a sample ring
+ * @param[in] *ring pointer to a max6675 ring structure
+ * @param[in] *buf pointer to a sample storage with MAX6675_RING_SIZE items
+ * @return    status code
+ *            - 0 success
+ *            - 2 ring or buf is NULL
+ * @note      none
+ */
+uint8_t max6675_ring_init(max6675_ring_t *ring, max6675_sample_t *buf);
+
+/**
+ * @brief     attach a sample ring to the handle
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *ring pointer to a max6675 ring structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      every frame read from the bus by the read functions is pushed into the attached ring,
+ *            the read functions are the only producer
+ */
+uint8_t max6675_set_ring(max6675_handle_t *handle, max6675_ring_t *ring);
+
+/**
+ * @brief     push a sample into the ring
+ * @param[in] *ring pointer to a max6675 ring structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ *            - 2 ring or sample is NULL
+ * @note      only one producer is allowed and a full ring drops the sample and counts an overrun
+ */
+uint8_t max6675_ring_push(max6675_ring_t *ring, const max6675_sample_t *sample);
+
+/**
+ * @brief      pop a sample from the ring
+ * @param[in]  *ring pointer to a max6675 ring structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 ring is empty
+ *             - 2 ring or sample is NULL
+ * @note       only one consumer is allowed
+ */
+uint8_t max6675_ring_pop(max6675_ring_t *ring, max6675_sample_t *sample);
+
+/**
+ * @brief      pop many samples from the ring
+ * @param[in]  *ring pointer to a max6675 ring structure
+ * @param[out] *sample pointer to a sample list
+ * @param[in]  len sample list length
+ * @param[out] *num pointer to a popped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ring, sample or num is NULL
+ * @note       only one consumer is allowed
+ */
+uint8_t max6675_ring_pop_many(max6675_ring_t *ring, max6675_sample_t *sample, uint32_t len, uint32_t *num);
+
+/**
+ * @brief      get the ring overrun counter
+ * @param[in]  *ring pointer to a max6675 ring structure
+ * @param[out] *overrun pointer to an overrun counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ring or overrun is NULL
+ * @note       none
+ */
+uint8_t max6675_ring_get_overrun(max6675_ring_t *ring, uint32_t *overrun);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup max6675_period_driver max6675 period driver function
+ * @brief    max6675 period driver modules
+ * @ingroup  max6675_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize a sampling period
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *period pointer to a max6675 period structure
+ * @param[in] period_ms sampling period in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or period is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ms is null
+ *            - 5 period_ms is 0
+ * @note      the first deadline is one period from now
+ */
+uint8_t max6675_period_init(max6675_handle_t *handle, max6675_period_t *period, uint32_t period_ms);
+
+/**
+ * @brief     wait for the next sampling deadline
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *period pointer to a max6675 period structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or period is NULL
+ *            - 3 handle is not initialized
+ * @note      the deadlines are absolute, so the read time and the wake up latency do not add
+ *            up over the samples, deadlines that have already passed by a whole period are
+ *            skipped and counted as overruns
+ */
+uint8_t max6675_period_wait(max6675_handle_t *handle, max6675_period_t *period);
+
+/**
+ * @brief      get the period overrun counter
+ * @param[in]  *period pointer to a max6675 period structure
+ * @param[out] *overrun pointer to an overrun counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 period or overrun is NULL
+ * @note       none
+ */
+uint8_t max6675_period_get_overrun(max6675_period_t *period, uint32_t *overrun);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup max6675_log_driver max6675 log driver function
+ * @brief    max6675 log driver modules
+ * @ingroup  max6675_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize a binary log
+ * @param[in] *log pointer to a max6675 log structure
+ * @param[in] *buf pointer to a record storage
+ * @param[in] size record storage length
+ * @return    status code
+ *            - 0 success
+ *            - 2 log or buf is NULL
+ *            - 4 size is invalid
+ * @note      none
+ */
+uint8_t max6675_log_init(max6675_log_t *log, max6675_log_record_t *buf, uint32_t size);
+
+/**
+ * @brief     clear a binary log
+ * @param[in] *log pointer to a max6675 log structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 log is NULL
+ * @note      the dropped counter is cleared too
+ */
+uint8_t max6675_log_clear(max6675_log_t *log);
+
+/**
+ * @brief     attach a binary log to the handle
+ * @param[in] *handle pointer to a max6675 handle structure
+ * @param[in] *log pointer to a max6675 log structure, NULL to detach
+ * @param[in] id handle id written into the records
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it can be called before max6675_init to record the init diagnostics,
+ *            the records are only written when MAX6675_LOG_BINARY is 1,
+ *            many handles can share one log when they are used from one thread
+ */
+uint8_t max6675_set_log(max6675_handle_t *handle, max6675_log_t *log, uint8_t id);
+
+/**
+ * @brief     get the message string of a log record
+ * @param[in] msg message id
+ * @return    pointer to the message string, NULL if the id is invalid
+ * @note      none
+ */
+const char *max6675_log_message(uint8_t msg);
+
 /**
  * @}
  */
@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_max6675_filter.c
+ * @brief     driver max6675 filter source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_max6675_filter.h"
+
+/**
+ * @brief ema fraction bits definition
+ */
+#define MAX6675_FILTER_EMA_BITS        8        /**< q8 state */
+
+/**
+ * @brief      update the sorted window
+ * @param[in]  *filter pointer to a max6675 filter structure
+ * @param[in]  old oldest sample
+ * @param[in]  raw new sample
+ * @note       the oldest sample is replaced by the new one with one insertion pass
+ */
+static void a_max6675_filter_sorted_replace(max6675_filter_t *filter, uint16_t old, uint16_t raw)
+{
+    uint8_t i;
+    
+    for (i = 0; i < filter->count; i++)                                            /* find the oldest sample */
+    {
+        if (filter->sorted[i] == old)                                              /* check the sample */
+        {
+            break;                                                                 /* found */
+        }
+    }
+    while ((i > 0) && (filter->sorted[i - 1] > raw))                               /* move the bigger samples right */
+    {
+        filter->sorted[i] = filter->sorted[i - 1];                                 /* shift */
+        i--;                                                                       /* next */
+    }
+    while (((i + 1) < filter->count) && (filter->sorted[i + 1] < raw))             /* move the smaller samples left */
+    {
+        filter->sorted[i] = filter->sorted[i + 1];                                 /* shift */
+        i++;                                                                       /* next */
+    }
+    filter->sorted[i] = raw;                                                       /* insert the new sample */
+}
+
+/**
+ * @brief      insert into the sorted window
+ * @param[in]  *filter pointer to a max6675 filter structure
+ * @param[in]  raw new sample
+ * @note       none
+ */
+static void a_max6675_filter_sorted_insert(max6675_filter_t *filter, uint16_t raw)
+{
+    uint8_t i;
+    
+    i = filter->count;                                                 /* start from the end */
+    while ((i > 0) && (filter->sorted[i - 1] > raw))                   /* move the bigger samples right */
+    {
+        filter->sorted[i] = filter->sorted[i - 1];                     /* shift */
+        i--;                                                           /* next */
+    }
+    filter->sorted[i] = raw;                                           /* insert the new sample */
+}
+
+/**
+ * @brief     initialize a filter
+ * @param[in] *filter pointer to a max6675 filter structure
+ * @param[in] type filter type
+ * @param[in] param ema shift or window length
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ *            - 4 param is invalid
+ * @note      ema alpha is 1 / 2^param and param is 1 - 8,
+ *            boxcar and median window is 1 - MAX6675_FILTER_MAX_WINDOW
+ */
+uint8_t max6675_filter_init(max6675_filter_t *filter, max6675_filter_type_t type, uint8_t param)
+{
+    if (filter == NULL)                                                              /* check filter */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (type == MAX6675_FILTER_TYPE_EMA)                                             /* ema */
+    {
+        if ((param < 1) || (param > MAX6675_FILTER_EMA_BITS))                        /* check param */
+        {
+            return 4;                                                                /* return error */
+        }
+    }
+    else if ((type == MAX6675_FILTER_TYPE_BOXCAR) ||
+             (type == MAX6675_FILTER_TYPE_MEDIAN))                                   /* boxcar and median */
+    {
+        if ((param < 1) || (param > MAX6675_FILTER_MAX_WINDOW))                      /* check param */
+        {
+            return 4;                                                                /* return error */
+        }
+    }
+    else if (type != MAX6675_FILTER_TYPE_NONE)                                       /* check type */
+    {
+        return 4;                                                                    /* return error */
+    }
+    else
+    {
+        /* no param */
+    }
+    
+    memset(filter, 0, sizeof(max6675_filter_t));                                     /* clear the filter */
+    filter->type = type;                                                             /* set the type */
+    filter->param = param;                                                           /* set the param */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     reset a filter
+ * @param[in] *filter pointer to a max6675 filter structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ * @note      the filter restarts from the next sample
+ */
+uint8_t max6675_filter_reset(max6675_filter_t *filter)
+{
+    if (filter == NULL)              /* check filter */
+    {
+        return 2;                    /* return error */
+    }
+    
+    filter->count = 0;               /* clear the count */
+    filter->index = 0;               /* clear the index */
+    filter->acc = 0;                 /* clear the state */
+    
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief      update a filter with a new sample
+ * @param[in]  *filter pointer to a max6675 filter structure
+ * @param[in]  raw raw data in 0.25C
+ * @param[out] *out pointer to a filtered raw data buffer in 0.25C
+ * @return     status code
+ *             - 0 success
+ *             - 2 filter or out is NULL
+ * @note       ema and boxcar run in constant time, median runs in window time
+ */
+uint8_t max6675_filter_update(max6675_filter_t *filter, uint16_t raw, uint16_t *out)
+{
+    uint16_t old;
+    
+    if ((filter == NULL) || (out == NULL))                                                    /* check filter and out */
+    {
+        return 2;                                                                             /* return error */
+    }
+    
+    if (filter->type == MAX6675_FILTER_TYPE_EMA)                                              /* ema */
+    {
+        if (filter->count == 0)                                                               /* first sample */
+        {
+            filter->acc = (int32_t)raw << MAX6675_FILTER_EMA_BITS;                            /* seed the state */
+            filter->count = 1;                                                                /* flag seeded */
+        }
+        else
+        {
+            filter->acc += (((int32_t)raw << MAX6675_FILTER_EMA_BITS) - filter->acc)
+                           / (1 << filter->param);                                            /* acc += alpha * (x - acc) */
+        }
+        *out = (uint16_t)((filter->acc + (1 << (MAX6675_FILTER_EMA_BITS - 1)))
+                          >> MAX6675_FILTER_EMA_BITS);                                        /* round the state */
+    }
+    else if (filter->type == MAX6675_FILTER_TYPE_BOXCAR)                                      /* boxcar */
+    {
+        if (filter->count < filter->param)                                                    /* window is not full */
+        {
+            filter->history[filter->count] = raw;                                             /* save the sample */
+            filter->count++;                                                                  /* count the sample */
+            filter->acc += raw;                                                               /* add to the sum */
+        }
+        else
+        {
+            old = filter->history[filter->index];                                             /* get the oldest sample */
+            filter->history[filter->index] = raw;                                             /* replace it */
+            filter->index = (uint8_t)((filter->index + 1) % filter->param);                   /* next oldest */
+            filter->acc += (int32_t)raw - (int32_t)old;                                       /* update the sum */
+        }
+        *out = (uint16_t)((filter->acc + filter->count / 2) / filter->count);                 /* get the average */
+    }
+    else if (filter->type == MAX6675_FILTER_TYPE_MEDIAN)                                      /* median */
+    {
+        if (filter->count < filter->param)                                                    /* window is not full */
+        {
+            filter->history[filter->count] = raw;                                             /* save the sample */
+            a_max6675_filter_sorted_insert(filter, raw);                                      /* insert the sample */
+            filter->count++;                                                                  /* count the sample */
+        }
+        else
+        {
+            old = filter->history[filter->index];                                             /* get the oldest sample */
+            filter->history[filter->index] = raw;                                             /* replace it */
+            filter->index = (uint8_t)((filter->index + 1) % filter->param);                   /* next oldest */
+            a_max6675_filter_sorted_replace(filter, old, raw);                                /* update the sorted window */
+        }
+        if ((filter->count % 2) != 0)                                                         /* odd window */
+        {
+            *out = filter->sorted[filter->count / 2];                                         /* get the median */
+        }
+        else
+        {
+            *out = (uint16_t)(((uint32_t)filter->sorted[filter->count / 2 - 1] +
+                              filter->sorted[filter->count / 2] + 1) / 2);                    /* average the middle */
+        }
+    }
+    else
+    {
+        *out = raw;                                                                           /* no filter */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature through a filter
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[in]  *filter pointer to a max6675 filter structure
+ * @param[out] *raw pointer to a raw data buffer in 0.25C
+ * @param[out] *out pointer to a filtered raw data buffer in 0.25C
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or filter is NULL
+ *             - 3 handle is not initialized
+ *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
+ * @note       the filter is only updated with the good samples, it is kept out of the handle so the
+ *             core driver has no filter state and one handle can feed several filters, so pass the
+ *             same filter with the handle on every read
+ */
+uint8_t max6675_filter_read(max6675_handle_t *handle, max6675_filter_t *filter, uint16_t *raw, uint16_t *out)
+{
+    uint8_t res;
+    int32_t temp;
+    
+    if (filter == NULL)                                        /* check filter */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    res = max6675_read_fixed(handle, raw, &temp);              /* read the temperature */
+    if (res != 0)                                              /* check result */
+    {
+        return res;                                            /* return error */
+    }
+    
+    return max6675_filter_update(filter, *raw, out);           /* update the filter */
+}
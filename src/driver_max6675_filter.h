@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_max6675_filter.h
+ * @brief     driver max6675 filter header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MAX6675_FILTER_H
+#define DRIVER_MAX6675_FILTER_H
+
+#include "driver_max6675.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup max6675_filter_driver max6675 filter driver function
+ * @brief    max6675 filter driver modules
+ * @ingroup  max6675_driver
+ * @{
+ */
+
+/**
+ * @brief max filter window definition
+ */
+#ifndef MAX6675_FILTER_MAX_WINDOW
+    #define MAX6675_FILTER_MAX_WINDOW        16        /**< 16 samples */
+#endif
+
+/**
+ * @brief max6675 filter type enumeration definition
+ */
+typedef enum
+{
+    MAX6675_FILTER_TYPE_NONE   = 0x00,        /**< no filter */
+    MAX6675_FILTER_TYPE_EMA    = 0x01,        /**< exponential moving average */
+    MAX6675_FILTER_TYPE_BOXCAR = 0x02,        /**< moving average */
+    MAX6675_FILTER_TYPE_MEDIAN = 0x03,        /**< moving median */
+} max6675_filter_type_t;
+
+/**
+ * @brief max6675 filter structure definition
+ */
+typedef struct max6675_filter_s
+{
+    max6675_filter_type_t type;                          /**< filter type */
+    uint8_t param;                                       /**< ema shift or window length */
+    uint8_t count;                                       /**< filled sample number */
+    uint8_t index;                                       /**< oldest sample index */
+    int32_t acc;                                         /**< ema state or running sum */
+    uint16_t history[MAX6675_FILTER_MAX_WINDOW];         /**< sample history */
+    uint16_t sorted[MAX6675_FILTER_MAX_WINDOW];          /**< sorted window */
+} max6675_filter_t;
+
+/**
+ * @brief     initialize a filter
+ * @param[in] *filter pointer to a max6675 filter structure
+ * @param[in] type filter type
+ * @param[in] param ema shift or window length
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ *            - 4 param is invalid
+ * @note      ema alpha is 1 / 2^param and param is 1 - 8,
+ *            boxcar and median window is 1 - MAX6675_FILTER_MAX_WINDOW
+ */
+uint8_t max6675_filter_init(max6675_filter_t *filter, max6675_filter_type_t type, uint8_t param);
+
+/**
+ * @brief     reset a filter
+ * @param[in] *filter pointer to a max6675 filter structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 filter is NULL
+ * @note      the filter restarts from the next sample
+ */
+uint8_t max6675_filter_reset(max6675_filter_t *filter);
+
+/**
+ * @brief      update a filter with a new sample
+ * @param[in]  *filter pointer to a max6675 filter structure
+ * @param[in]  raw raw data in 0.25C
+ * @param[out] *out pointer to a filtered raw data buffer in 0.25C
+ * @return     status code
+ *             - 0 success
+ *             - 2 filter or out is NULL
+ * @note       ema and boxcar run in constant time, median runs in window time
+ */
+uint8_t max6675_filter_update(max6675_filter_t *filter, uint16_t raw, uint16_t *out);
+
+/**
+ * @brief      read the temperature through a filter
+ * @param[in]  *handle pointer to a max6675 handle structure
+ * @param[in]  *filter pointer to a max6675 filter structure
+ * @param[out] *raw pointer to a raw data buffer in 0.25C
+ * @param[out] *out pointer to a filtered raw data buffer in 0.25C
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or filter is NULL
+ *             - 3 handle is not initialized
+ *             - 4 thermocouple input is open
+ *             - 5 read is busy
+ *             - 6 frame is corrupt
+ * @note       the filter is only updated with the good samples, it is kept out of the handle so the
+ *             core driver has no filter state and one handle can feed several filters, so pass the
+ *             same filter with the handle on every read
+ */
+uint8_t max6675_filter_read(max6675_handle_t *handle, max6675_filter_t *filter, uint16_t *raw, uint16_t *out);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
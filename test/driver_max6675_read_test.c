@@ -51,6 +51,9 @@ uint8_t max6675_read_test(uint32_t times)
     uint8_t res;
     uint32_t i;
     max6675_info_t info;
+    max6675_stats_t stats;
+    max6675_period_t period;
+    uint32_t overrun;
     
     /* link functions */
     DRIVER_MAX6675_LINK_INIT(&gs_handle, max6675_handle_t);
@@ -58,6 +61,8 @@ uint8_t max6675_read_test(uint32_t times)
     DRIVER_MAX6675_LINK_SPI_DEINIT(&gs_handle, max6675_interface_spi_deinit);
     DRIVER_MAX6675_LINK_SPI_READ_COMMAND(&gs_handle, max6675_interface_spi_read_cmd);
     DRIVER_MAX6675_LINK_DELAY_MS(&gs_handle, max6675_interface_delay_ms);
+    DRIVER_MAX6675_LINK_GET_TICK_MS(&gs_handle, max6675_interface_get_tick_ms);
+    DRIVER_MAX6675_LINK_WAIT_UNTIL_MS(&gs_handle, max6675_interface_wait_until_ms);
     DRIVER_MAX6675_LINK_DEBUG_PRINT(&gs_handle, max6675_interface_debug_print);
     
     /* max6675 info */
@@ -94,6 +99,51 @@ uint8_t max6675_read_test(uint32_t times)
     /* start read test */
     max6675_interface_debug_print("max6675: start read test.\n");
     
+    /* sample every 1000ms */
+    res = max6675_period_init(&gs_handle, &period, 1000);
+    if (res != 0)
+    {
+        max6675_interface_debug_print("max6675: period init failed.\n");
+        (void)max6675_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    for (i = 0; i < times; i++)
+    {
+        uint16_t raw;
+        float temp;
+        
+        /* read data */
+        res = max6675_read(&gs_handle, &raw, &temp);
+        if (res != 0)
+        {
+            max6675_interface_debug_print("max6675: read failed.\n");
+            (void)max6675_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        max6675_interface_debug_print("max6675: temperature is %0.2fC.\n", temp);
+        
+        /* wait for the next period */
+        (void)max6675_period_wait(&gs_handle, &period);
+    }
+    (void)max6675_period_get_overrun(&period, &overrun);
+    max6675_interface_debug_print("max6675: period overrun count is %u.\n", overrun);
+    
+    /* enable the cache */
+    res = max6675_set_cache(&gs_handle, MAX6675_BOOL_TRUE);
+    if (res != 0)
+    {
+        max6675_interface_debug_print("max6675: set cache failed.\n");
+        (void)max6675_deinit(&gs_handle);
+        
+        return 1;
+    }
+    max6675_interface_debug_print("max6675: enable the cache.\n");
+    
     for (i = 0; i < times; i++)
     {
         uint16_t raw;
@@ -112,9 +162,32 @@ uint8_t max6675_read_test(uint32_t times)
         /* output */
         max6675_interface_debug_print("max6675: temperature is %0.2fC.\n", temp);
         
-        /* delay 1000ms */
-        max6675_interface_delay_ms(1000);
+        /* delay 100ms */
+        max6675_interface_delay_ms(100);
+    }
+    
+    /* disable the cache */
+    res = max6675_set_cache(&gs_handle, MAX6675_BOOL_FALSE);
+    if (res != 0)
+    {
+        max6675_interface_debug_print("max6675: set cache failed.\n");
+        (void)max6675_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get the statistics */
+    res = max6675_get_stats(&gs_handle, &stats);
+    if (res != 0)
+    {
+        max6675_interface_debug_print("max6675: get stats failed.\n");
+        (void)max6675_deinit(&gs_handle);
+        
+        return 1;
     }
+    max6675_interface_debug_print("max6675: spi fail count is %u.\n", stats.spi_fail);
+    max6675_interface_debug_print("max6675: open count is %u.\n", stats.open);
+    max6675_interface_debug_print("max6675: corrupt count is %u.\n", stats.corrupt);
     
     /* finish read test */
     max6675_interface_debug_print("max6675: finish read test.\n");  